@@ -0,0 +1,81 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+
+// Shared helpers for the programs in bench/. Each program takes its sizes
+// as optional arguments; the defaults keep `make bench` short.
+
+// ---------------------- Timing ----------------------
+using BenchClock = std::chrono::steady_clock;
+
+inline double elapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+inline double elapsedUs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+}
+
+// p in [0, 1]; sorts samples in place
+inline double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t i = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+    return samples[i];
+}
+
+// ---------------------- Arguments ----------------------
+inline size_t argSize(int argc, char** argv, int i, size_t fallback) {
+    return argc > i ? std::strtoull(argv[i], nullptr, 10) : fallback;
+}
+
+// ---------------------- Synthetic Data ----------------------
+// Zipf(s) ranks in [0, n): rank 0 is the most frequent. Built once from
+// the cumulative weights, then sampled by binary search.
+class ZipfSampler {
+private:
+    std::vector<double> cdf;
+
+public:
+    ZipfSampler(size_t n, double s) : cdf(n) {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), s);
+            cdf[i] = total;
+        }
+        for (double& c : cdf) c /= total;
+    }
+
+    template<typename Rng>
+    size_t operator()(Rng& rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t i = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+        return std::min(i, cdf.size() - 1);
+    }
+};
+
+// ---------------------- Scratch Directory ----------------------
+// SystemCore reads and writes data/ under the working directory, so
+// benchmarks that drive it run from an empty directory under the system
+// temp path instead of the repo.
+inline std::string enterScratchDir(const std::string& name) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir / "data");
+    fs::current_path(dir);
+    std::printf("scratch directory: %s\n", dir.string().c_str());
+    return dir.string();
+}
+
+#endif // BENCH_UTIL_H
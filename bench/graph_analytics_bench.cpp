@@ -0,0 +1,103 @@
+#include "graph_analytics.h"
+#include "bench_util.h"
+
+// Follow graph analytics on a generated power-law graph of `edges`
+// distinct follows (10M by default). Out degrees are exponential; 70% of
+// follows go to accounts drawn with a cube bias towards low indexes, and
+// a fifth of follows are returned, so there are reciprocal pairs to
+// count. A few thousand follows and unfollows are left pending so the
+// delta path is read too.
+//
+// Reports summarizeGraph, degreesOfSeparation between random pairs and
+// from popular to random users, reachByDistance and mutualFollowers.
+//
+// usage: graph_analytics_bench [users] [edges] [queries]
+
+static constexpr double FOLLOW_BACK = 0.2;
+static constexpr size_t PENDING_EDITS = 3000;
+static constexpr int MAX_DEPTH = 6;
+static constexpr int REACH_DEPTH = 4;
+static constexpr size_t MUTUAL_QUERIES = 1000;
+
+int main(int argc, char** argv) {
+    const size_t userCount = argSize(argc, argv, 1, 1000000);
+    const size_t edgeTarget = argSize(argc, argv, 2, 10000000);
+    const size_t queries = argSize(argc, argv, 3, 50);
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto popular = [&]() { return static_cast<UserIdx>(userCount * std::pow(unit(rng), 3.0)); };
+    auto anyone = [&]() { return static_cast<UserIdx>(rng() % userCount); };
+
+    // Repeated and self follows are dropped, then the shortfall is drawn
+    // again from random followers until there are edgeTarget distinct edges
+    std::vector<std::pair<UserIdx, UserIdx>> follows;
+    follows.reserve(edgeTarget + edgeTarget / 5);
+    auto addFollow = [&](UserIdx u) {
+        UserIdx v = unit(rng) < 0.7 ? popular() : anyone();
+        if (v == u) return;
+        follows.emplace_back(u, v);
+        if (unit(rng) < FOLLOW_BACK) follows.emplace_back(v, u);
+    };
+    const double meanFollowing = static_cast<double>(edgeTarget) / userCount / (1.0 + FOLLOW_BACK);
+    for (size_t u = 0; u < userCount; ++u) {
+        size_t degree = static_cast<size_t>(-std::log(1.0 - unit(rng)) * meanFollowing);
+        for (size_t i = 0; i < degree; ++i) addFollow(static_cast<UserIdx>(u));
+    }
+    while (true) {
+        std::sort(follows.begin(), follows.end());
+        follows.erase(std::unique(follows.begin(), follows.end()), follows.end());
+        if (follows.size() >= edgeTarget) break;
+        for (size_t i = edgeTarget - follows.size(); i > 0; --i) addFollow(anyone());
+    }
+    SocialGraph graph;
+    auto start = BenchClock::now();
+    graph.bulkLoad(userCount, std::move(follows));
+    double loadMs = elapsedMs(start);
+    for (size_t i = 0; i < PENDING_EDITS; ++i) {
+        graph.follow(anyone(), anyone());
+        graph.unfollow(anyone(), anyone());
+    }
+    ThreadPool pool;
+    std::printf("%zu users, %zu follows, loaded in %.0f ms, %zu worker(s)\n",
+                userCount, graph.edgeCount(), loadMs, pool.size());
+
+    // ---------------------- Summary ----------------------
+    start = BenchClock::now();
+    GraphSummary s = summarizeGraph(graph, userCount, pool);
+    std::printf("  summarizeGraph      %8.0f ms  (%zu edges, %zu reciprocal pairs, %.1f%% followed back, max %u followers)\n",
+                elapsedMs(start), s.edges, s.reciprocalPairs, s.reciprocity * 100.0, s.followers.maxDegree);
+
+    // ---------------------- Searches ----------------------
+    for (bool fromPopular : {false, true}) {
+        std::vector<double> samples;
+        size_t unreachable = 0;
+        for (size_t q = 0; q < queries; ++q) {
+            UserIdx from = fromPopular ? popular() : anyone();
+            UserIdx to = anyone();
+            start = BenchClock::now();
+            if (degreesOfSeparation(graph, userCount, from, to, MAX_DEPTH, pool) < 0) unreachable++;
+            samples.push_back(elapsedMs(start));
+        }
+        std::printf("  degreesOfSeparation p50 %8.2f ms  p99 %8.2f ms  (%s -> random, %zu of %zu not within %d)\n",
+                    percentile(samples, 0.5), percentile(samples, 0.99), fromPopular ? "popular" : "random",
+                    unreachable, queries, MAX_DEPTH);
+    }
+
+    std::vector<size_t> counts;
+    start = BenchClock::now();
+    reachByDistance(graph, userCount, 1, REACH_DEPTH, pool, counts);
+    double reachMs = elapsedMs(start);
+    std::string reached;
+    for (size_t c : counts) reached += " " + std::to_string(c);
+    std::printf("  reachByDistance     %8.0f ms  (%d hops from a popular user:%s)\n", reachMs, REACH_DEPTH,
+                reached.c_str());
+
+    std::vector<UserIdx> mutual;
+    start = BenchClock::now();
+    for (size_t q = 0; q < MUTUAL_QUERIES; ++q) {
+        mutualFollowers(graph, static_cast<UserIdx>(rng() % 1000), static_cast<UserIdx>(rng() % 1000), mutual);
+    }
+    std::printf("  mutualFollowers     %8.3f ms per query  (%zu pairs among the 1000 most followed)\n",
+                elapsedMs(start) / MUTUAL_QUERIES, MUTUAL_QUERIES);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "sys_core.h"
+#include "utils.h"
+#include "bench_util.h"
+#include <fstream>
+
+// Text import speed: writes synthetic user.txt and posts.txt, then reports
+// the phases of SystemCore::loadAllData (read, parse, merge, index).
+// record_parse_bench times the per-record parsers on their own.
+//
+// usage: parse_bench [users] [posts]
+
+static std::string userList(std::mt19937_64& rng, size_t users, size_t count) {
+    std::string out;
+    for (size_t i = 0; i < count; ++i) {
+        if (i) out += ',';
+        out += "u_" + std::to_string(1000 + rng() % users);
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    const size_t users = argSize(argc, argv, 1, 5000);
+    const size_t posts = argSize(argc, argv, 2, 300000);
+    enterScratchDir("sfe_parse_bench");
+
+    std::mt19937_64 rng(42);
+    {
+        std::ofstream out("data/user.txt", std::ios::binary);
+        for (size_t i = 0; i < users; ++i) {
+            out << "u_" << 1000 + i << "|user" << i << "|" << urlEncode("User " + std::to_string(i))
+                << "|" << urlEncode("Bio of user " + std::to_string(i) + ", with punctuation!")
+                << "|" << userList(rng, users, rng() % 20) << "|" << userList(rng, users, rng() % 20) << "\n";
+        }
+        std::ofstream postOut("data/posts.txt", std::ios::binary);
+        for (size_t i = 0; i < posts; ++i) {
+            postOut << "p_" << 1000 + i << "|u_" << 1000 + rng() % users << "|" << 1700000000 + i * 7
+                    << "|" << rng() % 50 << "|"
+                    << urlEncode("Post number " + std::to_string(i) + ": some text, 100% synthetic | #bench")
+                    << "|" << userList(rng, users, rng() % 8) << "\n";
+        }
+    }
+
+    SystemCore& core = SystemCore::getInstance();
+    auto start = BenchClock::now();
+    core.loadAllData();
+    double totalMs = elapsedMs(start);
+    flushLog();
+
+    LoadTimings t = core.getLoadTimings();
+    std::printf("\nloaded %zu records in %zu chunks (%d users, %d posts)\n",
+                t.records, t.chunks, core.getUserCount(), core.getPostCount());
+    std::printf("  read   %9.1f ms\n", t.readMs);
+    std::printf("  parse  %9.1f ms\n", t.parseMs);
+    std::printf("  merge  %9.1f ms\n", t.mergeMs);
+    std::printf("  index  %9.1f ms\n", t.indexMs);
+    std::printf("  total  %9.1f ms\n", totalMs);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "post_table.h"
+#include "bench_util.h"
+#include <memory>
+
+// Sorting, scanning and top-K over N posts, once through pointers to
+// heap-allocated Post records and once over the PostTable columns. The
+// records are kept detached from the table so each side reads its own
+// like counts.
+//
+// The default is 1M posts (about 250 MB peak), which keeps `make bench`
+// short. The column layout targets around 10M posts, which needs about
+// 2.5 GB, mostly for the records and interned IDs; pass 10000000 to
+// measure at that size.
+//
+// usage: post_table_bench [posts]
+
+static constexpr size_t TOP_K = 100;
+static constexpr size_t AUTHORS = 100000;
+
+int main(int argc, char** argv) {
+    const size_t postCount = argSize(argc, argv, 1, 1000000);
+    std::mt19937_64 rng(42);
+
+    std::vector<std::unique_ptr<Post>> records;
+    records.reserve(postCount);
+    std::vector<PostIdx> handles;
+    handles.reserve(postCount);
+    PostTable table;
+    table.reserve(postCount);
+    for (size_t i = 0; i < postCount; ++i) {
+        std::string id = "p_" + std::to_string(i);
+        uint64_t ts = 1700000000 + rng() % 100000000;
+        auto p = std::make_unique<Post>(id, "u_" + std::to_string(rng() % AUTHORS), "post " + id, ts);
+        p->setLikes(static_cast<int>(rng() % 1000));
+        Post stored = *p;
+        table.store(stored);
+        handles.push_back(p->getIdx());
+        records.push_back(std::move(p));
+    }
+    std::printf("%zu posts, top %zu\n", postCount, TOP_K);
+
+    // ---------------------- Records ----------------------
+    std::vector<const Post*> ptrs;
+    ptrs.reserve(postCount);
+    for (const auto& p : records) ptrs.push_back(p.get());
+
+    auto start = BenchClock::now();
+    std::sort(ptrs.begin(), ptrs.end(), [](const Post* a, const Post* b) {
+        return a->getTimestamp() > b->getTimestamp();
+    });
+    double recordSortTime = elapsedMs(start);
+
+    start = BenchClock::now();
+    std::sort(ptrs.begin(), ptrs.end(), [](const Post* a, const Post* b) {
+        return a->getLikes() > b->getLikes();
+    });
+    double recordSortLikes = elapsedMs(start);
+
+    start = BenchClock::now();
+    uint64_t recordTotal = 0;
+    for (const auto& p : records) recordTotal += p->getLikes();
+    double recordScan = elapsedMs(start);
+
+    ptrs.clear();
+    for (const auto& p : records) ptrs.push_back(p.get());
+    start = BenchClock::now();
+    std::partial_sort(ptrs.begin(), ptrs.begin() + std::min(TOP_K, ptrs.size()), ptrs.end(),
+                      [](const Post* a, const Post* b) { return a->getLikes() > b->getLikes(); });
+    double recordTop = elapsedMs(start);
+
+    // ---------------------- Columns ----------------------
+    std::vector<PostIdx> byTime = handles, byLikes = handles;
+    start = BenchClock::now();
+    table.sort(byTime, PostOrder::Newest);
+    double columnSortTime = elapsedMs(start);
+
+    start = BenchClock::now();
+    table.sort(byLikes, PostOrder::MostLiked);
+    double columnSortLikes = elapsedMs(start);
+
+    start = BenchClock::now();
+    uint64_t columnTotal = table.totalLikes();
+    double columnScan = elapsedMs(start);
+
+    std::vector<PostIdx> top;
+    start = BenchClock::now();
+    table.top(TOP_K, PostOrder::MostLiked, top);
+    double columnTop = elapsedMs(start);
+    bool topMatches = std::equal(top.begin(), top.end(), byLikes.begin());
+
+    std::printf("  %-8s sort by time %8.1f ms  by likes %8.1f ms  like scan %6.2f ms  top-%zu %6.2f ms\n",
+                "records", recordSortTime, recordSortLikes, recordScan, TOP_K, recordTop);
+    std::printf("  %-8s sort by time %8.1f ms  by likes %8.1f ms  like scan %6.2f ms  top-%zu %6.2f ms\n",
+                "columns", columnSortTime, columnSortLikes, columnScan, TOP_K, columnTop);
+    std::printf("  column bytes %zu, totals %s, top-K %s sort\n", table.memoryBytes(),
+                recordTotal == columnTotal ? "agree" : "DIFFER", topMatches ? "matches" : "DIFFERS from");
+    return recordTotal == columnTotal && topMatches ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "sys_core.h"
+#include "async_logger.h"
+#include "feed_ranker.h"
+#include "bench_util.h"
+
+// Ranked feed latency at growing candidate counts. First the scoring pass
+// alone (rankCandidates over synthetic FeedCandidates, one row per scorer),
+// then the whole getRankedFeed call for one reader who follows AUTHORS
+// accounts, which adds candidate collection and the lock.
+//
+// usage: ranked_feed_bench [max candidates] [repetitions]
+
+static constexpr size_t AUTHORS = 200;
+static constexpr size_t TOP_K = 20;
+
+static std::string userID(size_t i) { return "u_" + std::to_string(1000 + i); }
+
+template<typename Scorer>
+static void benchScorer(const char* name, const FeedCandidates& c, const Scorer& scorer, size_t reps) {
+    std::vector<float> scores;
+    std::vector<uint32_t> order;
+    std::vector<double> samples;
+    for (size_t r = 0; r < reps; ++r) {
+        auto start = BenchClock::now();
+        rankCandidates(c, scorer, TOP_K, scores, order);
+        samples.push_back(elapsedUs(start));
+    }
+    std::printf("  %-14s p50 %8.1f us  p99 %8.1f us\n", name, percentile(samples, 0.5), percentile(samples, 0.99));
+}
+
+int main(int argc, char** argv) {
+    const size_t maxCandidates = argSize(argc, argv, 1, 100000);
+    const size_t reps = argSize(argc, argv, 2, 100);
+    enterScratchDir("sfe_ranked_feed_bench");
+    AsyncLogger::getInstance().setMinLevel(LogLevel::Warning);
+    std::mt19937_64 rng(11);
+
+    std::vector<size_t> sizes;
+    for (size_t n = 1000; n <= maxCandidates; n *= 10) sizes.push_back(n);
+
+    // ---------------------- Scoring ----------------------
+    for (size_t n : sizes) {
+        FeedCandidates c;
+        c.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            c.posts[i] = static_cast<PostIdx>(i);
+            c.ageHours[i] = static_cast<float>(i) * 72.0f / n;
+            c.likes[i] = static_cast<float>(rng() % 500);
+            c.affinity[i] = static_cast<float>(rng() % 8);
+        }
+        std::printf("rankCandidates, %zu candidates, top %zu\n", n, TOP_K);
+        benchScorer("recency", c, RecencyScorer(), reps);
+        benchScorer("like velocity", c, LikeVelocityScorer(), reps);
+        benchScorer("engagement", c, EngagementScorer(), reps);
+    }
+
+    // ---------------------- Ranked Feed ----------------------
+    SystemCore& core = SystemCore::getInstance();
+    core.loadAllData();
+    core.setFsyncPolicy(FsyncPolicy::Never);
+    const std::string reader = userID(AUTHORS);
+    for (size_t i = 0; i <= AUTHORS; ++i) {
+        core.addUser(User(userID(i), "user" + std::to_string(i)));
+    }
+    for (size_t i = 0; i < AUTHORS; ++i) {
+        core.followUser(reader, userID(i));
+    }
+    uint64_t ts = 1700000000;
+    for (size_t i = 0; i < maxCandidates; ++i) {
+        std::string id = "p_" + std::to_string(1000 + i);
+        core.addPost(Post(id, userID(rng() % AUTHORS), "post " + id, ts++));
+        if (rng() % 4 == 0) core.likePost(reader, id);
+    }
+    core.flushLikes();
+
+    std::printf("getRankedFeed, %zu followees, top %zu\n", AUTHORS, TOP_K);
+    for (size_t n : sizes) {
+        std::vector<double> ranked, page;
+        for (size_t r = 0; r < reps; ++r) {
+            auto start = BenchClock::now();
+            core.getRankedFeed<EngagementScorer>(reader, TOP_K, EngagementScorer(), n);
+            ranked.push_back(elapsedUs(start));
+        }
+        for (size_t r = 0; r < reps; ++r) {
+            auto start = BenchClock::now();
+            core.getFeedPage(reader, n);
+            page.push_back(elapsedUs(start));
+        }
+        std::printf("  %6zu candidates  ranked p50 %8.1f us  p99 %8.1f us   chronological page p50 %8.1f us  p99 %8.1f us\n",
+                    n, percentile(ranked, 0.5), percentile(ranked, 0.99), percentile(page, 0.5), percentile(page, 0.99));
+    }
+    return 0;
+}
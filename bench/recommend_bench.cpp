@@ -0,0 +1,112 @@
+#include "follow_recommender.h"
+#include "thread_pool.h"
+#include "bench_util.h"
+
+// Friend-of-friend suggestion latency on a power-law follow graph. Out
+// degrees are exponential around MEAN_FOLLOWING; 70% of follows go to
+// accounts drawn with a cube bias towards low indexes, so a few accounts
+// gather most followers. Every 10000th user follows HEAVY_FOLLOWING
+// accounts. Likes are drawn the same way for engagement weighting.
+//
+// Reports on-demand queries with a fresh FollowRecommender (first query
+// on a thread) and with a reused one, the heavy account, and a batch run
+// of `batch` users in 256-user blocks on the pool, scheduled the way
+// SystemCore::precomputeRecommendations does it. Pass the user count as the
+// batch size to time a full precompute.
+//
+// usage: recommend_bench [users] [batch] [queries]
+
+static constexpr size_t MEAN_FOLLOWING = 20;
+static constexpr size_t HEAVY_FOLLOWING = 5000;
+static constexpr size_t LIKES_PER_USER = 5;
+static constexpr size_t SUGGESTIONS = 20;
+static constexpr size_t BLOCK = 256;
+
+int main(int argc, char** argv) {
+    const size_t userCount = argSize(argc, argv, 1, 1000000);
+    const size_t batch = std::min(userCount, argSize(argc, argv, 2, 20000));
+    const size_t queries = argSize(argc, argv, 3, 200);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto popular = [&]() { return static_cast<UserIdx>(userCount * std::pow(unit(rng), 3.0)); };
+
+    std::vector<std::pair<UserIdx, UserIdx>> follows;
+    follows.reserve(userCount * MEAN_FOLLOWING);
+    for (size_t u = 0; u < userCount; ++u) {
+        size_t degree = u % 10000 == 0 ? HEAVY_FOLLOWING
+                                       : static_cast<size_t>(-std::log(1.0 - unit(rng)) * MEAN_FOLLOWING);
+        for (size_t i = 0; i < degree; ++i) {
+            UserIdx v = unit(rng) < 0.7 ? popular() : static_cast<UserIdx>(rng() % userCount);
+            follows.emplace_back(static_cast<UserIdx>(u), v);
+        }
+    }
+    SocialGraph graph;
+    auto start = BenchClock::now();
+    graph.bulkLoad(userCount, std::move(follows));
+    std::printf("%zu users, %zu follows, loaded in %.0f ms\n", userCount, graph.edgeCount(), elapsedMs(start));
+
+    std::vector<std::pair<UserIdx, UserIdx>> likes;
+    likes.reserve(userCount * LIKES_PER_USER);
+    for (size_t i = 0; i < userCount * LIKES_PER_USER; ++i) {
+        likes.emplace_back(static_cast<UserIdx>(rng() % userCount), popular());
+    }
+    AuthorAffinity affinity;
+    affinity.bulkLoad(std::move(likes));
+
+    // ---------------------- On Demand ----------------------
+    std::vector<FollowSuggestion> out;
+    const AuthorAffinity* modes[] = {nullptr, &affinity};
+    for (const AuthorAffinity* weights : modes) {
+        const char* mode = weights ? "engagement" : "mutual only";
+        std::vector<double> cold, warm;
+        for (size_t q = 0; q < queries; ++q) {
+            UserIdx u = static_cast<UserIdx>(rng() % userCount);
+            start = BenchClock::now();
+            FollowRecommender fresh;
+            fresh.recommend(graph, weights, u, SUGGESTIONS, out);
+            cold.push_back(elapsedMs(start));
+        }
+        FollowRecommender reused;
+        for (size_t q = 0; q < queries; ++q) {
+            UserIdx u = static_cast<UserIdx>(rng() % userCount);
+            start = BenchClock::now();
+            reused.recommend(graph, weights, u, SUGGESTIONS, out);
+            warm.push_back(elapsedMs(start));
+        }
+        start = BenchClock::now();
+        reused.recommend(graph, weights, 0, SUGGESTIONS, out);
+        double heavy = elapsedMs(start);
+        std::printf("  %-11s  fresh p50 %6.2f ms p99 %6.2f ms   reused p50 %6.3f ms p99 %6.3f ms   %zu-follow user %6.2f ms\n",
+                    mode, percentile(cold, 0.5), percentile(cold, 0.99), percentile(warm, 0.5),
+                    percentile(warm, 0.99), HEAVY_FOLLOWING, heavy);
+    }
+
+    // ---------------------- Batch ----------------------
+    // One task per block, at most half the pool in flight, one recommender per slot
+    ThreadPool pool;
+    const size_t slots = std::max<size_t>(1, pool.size() / 2);
+    std::vector<FollowRecommender> recommenders(slots);
+    std::vector<std::future<void>> inFlight(slots);
+    std::vector<std::vector<FollowSuggestion>> lists(batch);
+    start = BenchClock::now();
+    size_t block = 0;
+    for (size_t begin = 0; begin < batch; begin += BLOCK, ++block) {
+        size_t slot = block % slots;
+        if (inFlight[slot].valid()) inFlight[slot].get();
+        FollowRecommender& recommender = recommenders[slot];
+        inFlight[slot] = pool.submit([&, begin] {
+            size_t end = std::min(batch, begin + BLOCK);
+            for (size_t u = begin; u < end; ++u) {
+                recommender.recommend(graph, &affinity, static_cast<UserIdx>(u), SUGGESTIONS, lists[u]);
+            }
+        });
+    }
+    for (std::future<void>& f : inFlight) {
+        if (f.valid()) f.get();
+    }
+    double batchMs = elapsedMs(start);
+    std::printf("batch: %zu users, %zu of %zu worker(s) in %.0f ms, %.1f us per user (all %zu users: ~%.0f s)\n",
+                batch, slots, pool.size(), batchMs, batchMs * 1000.0 / batch, userCount,
+                batchMs / batch * userCount / 1000.0);
+    return 0;
+}
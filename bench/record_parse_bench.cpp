@@ -0,0 +1,151 @@
+#include "post.h"
+#include "user.h"
+#include "utils.h"
+#include "field_parser.h"
+#include "bench_util.h"
+
+// Per-record parse speed, without file I/O or SystemCore, over the same
+// synthetic posts.txt and user.txt lines as parse_bench. Three paths:
+//   legacy       safeSplit + urlDecode + stoull, into std::strings (the
+//                original Post/User::deserialize)
+//   tokenizer    FieldTokenizer + percentDecodeInto + parseUint64 into
+//                reused buffers (the same fields, the current load path)
+//   deserialize  Post/User::deserialize, which also interns every ID
+//                (author, likers, follow lists) and stores the text in
+//                the arena
+// Interning is most of the deserialize time, so that row trails the
+// legacy one here; the legacy strings pay for it later, when the follow
+// graph and like index are built from them. Each path runs PASSES times;
+// the best pass is reported.
+//
+// usage: record_parse_bench [users] [posts]
+
+static constexpr int PASSES = 3;
+
+static std::string userList(std::mt19937_64& rng, size_t users, size_t count) {
+    std::string out;
+    for (size_t i = 0; i < count; ++i) {
+        if (i) out += ',';
+        out += "u_" + std::to_string(1000 + rng() % users);
+    }
+    return out;
+}
+
+// Best of PASSES runs of parse over every line, in records per second
+template<typename Parse>
+static double recordsPerSecond(const std::vector<std::string>& lines, Parse parse, size_t& sink) {
+    double best = 0.0;
+    for (int pass = 0; pass < PASSES; ++pass) {
+        auto start = BenchClock::now();
+        for (const std::string& line : lines) sink += parse(line);
+        double rate = lines.size() / (elapsedMs(start) / 1000.0);
+        best = std::max(best, rate);
+    }
+    return best;
+}
+
+static void report(const char* kind, const char* path, double rate, double legacyRate) {
+    std::printf("  %-6s %-12s %7.2f M records/s  (%.1fx legacy)\n", kind, path, rate / 1e6, rate / legacyRate);
+}
+
+// ---------------------- Legacy ----------------------
+static size_t legacyPost(const std::string& line) {
+    std::vector<std::string> parts = safeSplit(line, '|');
+    std::string content = urlDecode(parts[4]);
+    uint64_t ts = std::stoull(parts[2]);
+    int likes = std::stoi(parts[3]);
+    size_t likers = parts.size() > 5 && !parts[5].empty() ? safeSplit(parts[5], ',').size() : 0;
+    return parts[0].size() + parts[1].size() + content.size() + likers + static_cast<size_t>(ts + likes);
+}
+
+static size_t legacyUser(const std::string& line) {
+    std::vector<std::string> parts = safeSplit(line, '|');
+    std::string name = urlDecode(parts[2]);
+    std::string bio = urlDecode(parts[3]);
+    size_t followers = parts.size() > 4 && !parts[4].empty() ? safeSplit(parts[4], ',').size() : 0;
+    size_t following = parts.size() > 5 && !parts[5].empty() ? safeSplit(parts[5], ',').size() : 0;
+    return parts[0].size() + parts[1].size() + name.size() + bio.size() + followers + following;
+}
+
+// ---------------------- Tokenizer ----------------------
+static size_t countIds(std::string_view list) {
+    if (list.empty()) return 0;
+    FieldTokenizer ids(list, ',');
+    std::string_view id;
+    size_t n = 0;
+    while (ids.next(id)) n += !id.empty();
+    return n;
+}
+
+static size_t tokenizerPost(const std::string& line) {
+    static thread_local std::string content;
+    std::string_view f[6];
+    size_t n = splitFields(line, '|', f, 6);
+    uint64_t ts = 0;
+    int likes = 0;
+    parseUint64(f[2], ts);
+    parseInt(f[3], likes);
+    content.resize(f[4].size());
+    content.resize(percentDecodeInto(f[4], &content[0]));
+    size_t likers = n > 5 ? countIds(f[5]) : 0;
+    return f[0].size() + f[1].size() + content.size() + likers + static_cast<size_t>(ts + likes);
+}
+
+static size_t tokenizerUser(const std::string& line) {
+    static thread_local std::string name, bio;
+    std::string_view f[6];
+    size_t n = splitFields(line, '|', f, 6);
+    name.resize(f[2].size());
+    name.resize(percentDecodeInto(f[2], &name[0]));
+    bio.resize(f[3].size());
+    bio.resize(percentDecodeInto(f[3], &bio[0]));
+    size_t followers = n > 4 ? countIds(f[4]) : 0;
+    size_t following = n > 5 ? countIds(f[5]) : 0;
+    return f[0].size() + f[1].size() + name.size() + bio.size() + followers + following;
+}
+
+int main(int argc, char** argv) {
+    const size_t userCount = argSize(argc, argv, 1, 50000);
+    const size_t postCount = argSize(argc, argv, 2, 300000);
+    std::mt19937_64 rng(42);
+
+    std::vector<std::string> userLines, postLines;
+    userLines.reserve(userCount);
+    postLines.reserve(postCount);
+    for (size_t i = 0; i < userCount; ++i) {
+        userLines.push_back("u_" + std::to_string(1000 + i) + "|user" + std::to_string(i) + "|" +
+                            urlEncode("User " + std::to_string(i)) + "|" +
+                            urlEncode("Bio of user " + std::to_string(i) + ", with punctuation!") + "|" +
+                            userList(rng, userCount, rng() % 20) + "|" + userList(rng, userCount, rng() % 20));
+    }
+    for (size_t i = 0; i < postCount; ++i) {
+        postLines.push_back("p_" + std::to_string(1000 + i) + "|u_" + std::to_string(1000 + rng() % userCount) +
+                            "|" + std::to_string(1700000000 + i * 7) + "|" + std::to_string(rng() % 50) + "|" +
+                            urlEncode("Post number " + std::to_string(i) + ": some text, 100% synthetic | #bench") +
+                            "|" + userList(rng, userCount, rng() % 8));
+    }
+    std::printf("%zu user lines, %zu post lines, best of %d passes\n", userCount, postCount, PASSES);
+
+    size_t sink = 0;
+    std::vector<UserIdx> ids, ids2;
+    double legacy = recordsPerSecond(postLines, legacyPost, sink);
+    report("posts", "legacy", legacy, legacy);
+    report("posts", "tokenizer", recordsPerSecond(postLines, tokenizerPost, sink), legacy);
+    report("posts", "deserialize", recordsPerSecond(postLines, [&](const std::string& line) {
+        ids.clear();
+        return Post::deserialize(line, &ids).contentSize() + ids.size();
+    }, sink), legacy);
+
+    legacy = recordsPerSecond(userLines, legacyUser, sink);
+    report("users", "legacy", legacy, legacy);
+    report("users", "tokenizer", recordsPerSecond(userLines, tokenizerUser, sink), legacy);
+    report("users", "deserialize", recordsPerSecond(userLines, [&](const std::string& line) {
+        ids.clear();
+        ids2.clear();
+        User u = User::deserialize(line, &ids, &ids2);
+        return u.getName().size() + ids.size() + ids2.size();
+    }, sink), legacy);
+
+    std::printf("  (checksum %zu)\n", sink);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "search_index.h"
+#include "bench_util.h"
+#include <thread>
+
+// Search index build time on one and on several threads, query latency
+// for AND and OR queries of common and rare words, and incremental adds.
+// Post texts are 8-19 words drawn from a Zipf distribution over VOCABULARY
+// words; the first AND query is also answered by tokenizing every post,
+// as the unindexed baseline and as a check on the index.
+//
+// usage: search_bench [posts] [repetitions]
+
+static constexpr size_t VOCABULARY = 50000;
+static constexpr size_t INCREMENTAL_ADDS = 10000;
+
+int main(int argc, char** argv) {
+    const size_t postCount = argSize(argc, argv, 1, 500000);
+    const size_t reps = argSize(argc, argv, 2, 50);
+    std::mt19937_64 rng(1);
+    ZipfSampler popularity(VOCABULARY, 1.0);
+
+    std::vector<std::string> texts(postCount);
+    for (std::string& text : texts) {
+        for (size_t n = 8 + rng() % 12; n > 0; --n) {
+            text += "w" + std::to_string(popularity(rng));
+            text += ' ';
+        }
+    }
+    std::vector<std::pair<PostIdx, std::string_view>> docs;
+    docs.reserve(postCount);
+    for (size_t i = 0; i < postCount; ++i) docs.emplace_back(static_cast<PostIdx>(i), texts[i]);
+    const std::vector<std::pair<UserIdx, UserText>> users;
+
+    // ---------------------- Build ----------------------
+    const size_t threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+    SearchIndex index;
+    for (size_t n : {size_t(1), threads}) {
+        ThreadPool pool(n);
+        auto start = BenchClock::now();
+        index.build(pool, docs, users);
+        std::printf("build, %zu posts, %zu thread(s): %.1f ms\n", postCount, n, elapsedMs(start));
+    }
+    SearchStats stats = index.stats();
+    std::printf("%zu terms, %zu postings, lists %.1f MB (%.1f MB as 32-bit arrays)\n",
+                stats.postTerms, stats.postings, stats.listBytes / 1048576.0, stats.rawListBytes / 1048576.0);
+
+    // ---------------------- Queries ----------------------
+    const std::vector<std::vector<std::string>> queries = {
+        {"w20", "w300"}, {"w5000"}, {"w0", "w1"}, {"w100", "w4000"}, {"w10", "w20", "w30"}};
+    std::vector<PostIdx> hits;
+    for (SearchMode mode : {SearchMode::All, SearchMode::Any}) {
+        for (const std::vector<std::string>& q : queries) {
+            std::vector<double> samples;
+            for (size_t r = 0; r < reps; ++r) {
+                auto start = BenchClock::now();
+                index.findPosts(q, mode, hits);
+                samples.push_back(elapsedUs(start));
+            }
+            std::string text;
+            for (const std::string& term : q) text += (text.empty() ? "" : mode == SearchMode::All ? " AND " : " OR ") + term;
+            std::printf("  %-22s %8zu hits  p50 %9.1f us  p99 %9.1f us\n",
+                        text.c_str(), hits.size(), percentile(samples, 0.5), percentile(samples, 0.99));
+        }
+    }
+
+    // ---------------------- Baseline ----------------------
+    const std::vector<std::string>& q = queries[0];
+    index.findPosts(q, SearchMode::All, hits);
+    auto start = BenchClock::now();
+    std::vector<std::string> terms;
+    size_t scanned = 0;
+    for (const std::string& text : texts) {
+        SearchIndex::tokenize(text, terms);
+        if (std::all_of(q.begin(), q.end(), [&](const std::string& t) {
+                return std::find(terms.begin(), terms.end(), t) != terms.end();
+            })) {
+            scanned++;
+        }
+    }
+    std::printf("  full scan for %s AND %s: %.1f ms, %zu hits (%s)\n", q[0].c_str(), q[1].c_str(),
+                elapsedMs(start), scanned, scanned == hits.size() ? "agrees" : "DIFFERS");
+
+    start = BenchClock::now();
+    for (size_t i = 0; i < INCREMENTAL_ADDS && i < postCount; ++i) {
+        index.addPost(static_cast<PostIdx>(postCount + i), texts[i]);
+    }
+    std::printf("  %zu incremental adds: %.1f ms\n", INCREMENTAL_ADDS, elapsedMs(start));
+    return scanned == hits.size() ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "sys_core.h"
+#include "async_logger.h"
+#include "bench_util.h"
+
+// Feed read and post write latency for each FeedStrategy on a power-law
+// follow graph: followees are drawn from a Zipf distribution, so a few
+// accounts collect most of the followers and cross the celebrity
+// threshold.
+//
+// usage: timeline_bench [users] [posts] [threshold]
+
+static constexpr size_t FOLLOWS_PER_USER = 40;
+static constexpr size_t PAGE_SIZE = 20;
+static constexpr size_t READS = 2000;
+static constexpr size_t WRITES = 2000;
+
+static std::string userID(size_t i) { return "u_" + std::to_string(1000 + i); }
+
+static const char* strategyName(FeedStrategy s) {
+    switch (s) {
+        case FeedStrategy::FanOutOnRead: return "fan-out-on-read";
+        case FeedStrategy::FanOutOnWrite: return "fan-out-on-write";
+        default: return "hybrid";
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t userCount = argSize(argc, argv, 1, 5000);
+    const size_t postCount = argSize(argc, argv, 2, 100000);
+    const size_t threshold = argSize(argc, argv, 3, 100);
+    enterScratchDir("sfe_timeline_bench");
+    AsyncLogger::getInstance().setMinLevel(LogLevel::Warning);
+
+    SystemCore& core = SystemCore::getInstance();
+    core.loadAllData();
+    core.setFsyncPolicy(FsyncPolicy::Never);
+    std::mt19937_64 rng(7);
+    ZipfSampler popularity(userCount, 1.0);
+
+    for (size_t i = 0; i < userCount; ++i) {
+        core.addUser(User(userID(i), "user" + std::to_string(i)));
+    }
+    for (size_t i = 0; i < userCount; ++i) {
+        for (size_t f = 0; f < FOLLOWS_PER_USER; ++f) {
+            size_t target = popularity(rng);
+            if (target != i) core.followUser(userID(i), userID(target));
+        }
+    }
+    uint64_t ts = 1700000000;
+    size_t nextPost = 1000;
+    auto newPost = [&]() {
+        std::string id = "p_" + std::to_string(nextPost++);
+        return Post(id, userID(popularity(rng)), "post " + id, ts++);
+    };
+    for (size_t i = 0; i < postCount; ++i) {
+        core.addPost(newPost());
+    }
+    std::printf("%zu users, %zu posts, threshold %zu, %zu-post pages\n",
+                userCount, postCount, threshold, PAGE_SIZE);
+
+    for (FeedStrategy strategy : {FeedStrategy::FanOutOnRead, FeedStrategy::FanOutOnWrite, FeedStrategy::Hybrid}) {
+        core.setFeedStrategy(strategy, threshold);
+
+        // Rebuild each reader's timeline once so reads measure the steady state
+        std::vector<std::string> readers;
+        for (size_t i = 0; i < READS; ++i) readers.push_back(userID(rng() % userCount));
+        for (const std::string& r : readers) core.getFeedPage(r, PAGE_SIZE);
+
+        std::vector<double> reads;
+        for (const std::string& r : readers) {
+            auto start = BenchClock::now();
+            core.getFeedPage(r, PAGE_SIZE);
+            reads.push_back(elapsedUs(start));
+        }
+        std::vector<double> writes;
+        for (size_t i = 0; i < WRITES; ++i) {
+            Post p = newPost();
+            auto start = BenchClock::now();
+            core.addPost(p);
+            writes.push_back(elapsedUs(start));
+        }
+        std::printf("  %-17s read p50 %7.1f us  p99 %7.1f us   write p50 %7.1f us  p99 %7.1f us\n",
+                    strategyName(strategy), percentile(reads, 0.5), percentile(reads, 0.99),
+                    percentile(writes, 0.5), percentile(writes, 0.99));
+    }
+    return 0;
+}
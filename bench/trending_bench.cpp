@@ -0,0 +1,88 @@
+#include "trending.h"
+#include "bench_util.h"
+#include <unordered_map>
+
+// Trending hashtag ingest rate, top-K query latency and accuracy. Posts
+// span three days and carry up to three hashtags drawn from a Zipf
+// distribution over TAGS tags. Each window's top-K is then checked against
+// exact counts over the same buckets.
+//
+// usage: trending_bench [posts] [queries]
+
+static constexpr size_t TAGS = 50000;
+static constexpr size_t TOP_K = 10;
+static constexpr uint64_t SPAN_SECONDS = 3 * 86400;
+
+int main(int argc, char** argv) {
+    const size_t postCount = argSize(argc, argv, 1, 1000000);
+    const size_t queries = argSize(argc, argv, 2, 10000);
+    std::mt19937_64 rng(7);
+    ZipfSampler popularity(TAGS, 1.1);
+
+    std::vector<std::string> texts;
+    std::vector<uint64_t> timestamps;
+    texts.reserve(postCount);
+    timestamps.reserve(postCount);
+    const uint64_t t0 = 1700000000;
+    for (size_t i = 0; i < postCount; ++i) {
+        std::string text = "Just posted something about stuff";
+        for (size_t t = rng() % 4; t > 0; --t) text += " #Tag" + std::to_string(popularity(rng));
+        texts.push_back(std::move(text));
+        timestamps.push_back(t0 + SPAN_SECONDS * i / postCount + rng() % 120);
+    }
+
+    // ---------------------- Ingest ----------------------
+    TrendingHashtags trending;
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < postCount; ++i) trending.add(texts[i], timestamps[i]);
+    double ingestMs = elapsedMs(start);
+    TrendingStats stats = trending.stats();
+    std::printf("%zu posts, %llu hashtags: %.2f M posts/s, %.2f M hashtags/s, %zu bytes, %llu stale\n",
+                postCount, static_cast<unsigned long long>(stats.hashtags),
+                postCount / ingestMs / 1000.0, stats.hashtags / ingestMs / 1000.0,
+                stats.bytes, static_cast<unsigned long long>(stats.stale));
+
+    // ---------------------- Queries ----------------------
+    std::vector<TrendingTag> top;
+    std::vector<double> samples;
+    for (size_t q = 0; q < queries; ++q) {
+        TrendWindow window = q % 2 ? TrendWindow::LastDay : TrendWindow::LastHour;
+        start = BenchClock::now();
+        trending.top(window, TOP_K, top);
+        samples.push_back(elapsedUs(start));
+    }
+    std::printf("top-%zu query p50 %.2f us  p99 %.2f us\n", TOP_K, percentile(samples, 0.5), percentile(samples, 0.99));
+
+    // ---------------------- Accuracy ----------------------
+    const uint64_t head = *std::max_element(timestamps.begin(), timestamps.end()) / TrendingHashtags::BUCKET_SECONDS;
+    std::vector<std::string> tags;
+    for (TrendWindow window : {TrendWindow::LastHour, TrendWindow::LastDay}) {
+        const uint64_t width = window == TrendWindow::LastHour ? 3600 / TrendingHashtags::BUCKET_SECONDS
+                                                               : TrendingHashtags::BUCKETS;
+        std::unordered_map<std::string, uint32_t> exact;
+        for (size_t i = 0; i < postCount; ++i) {
+            if (timestamps[i] / TrendingHashtags::BUCKET_SECONDS + width <= head) continue;
+            TrendingHashtags::extractHashtags(texts[i], tags);
+            for (const std::string& tag : tags) exact[tag]++;
+        }
+        std::vector<std::pair<uint32_t, std::string>> ranked;
+        for (const auto& entry : exact) ranked.emplace_back(entry.second, entry.first);
+        size_t k = std::min(TOP_K, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(),
+                          [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+        trending.top(window, TOP_K, top);
+        size_t overlap = 0;
+        double overcount = 0.0;
+        for (const TrendingTag& t : top) {
+            for (size_t i = 0; i < k; ++i) {
+                if (ranked[i].second == t.tag) overlap++;
+            }
+            overcount = std::max(overcount, static_cast<double>(t.count) / exact[t.tag] - 1.0);
+        }
+        std::printf("  %-9s top-%zu overlap %zu/%zu, max overcount %.2f%%\n",
+                    window == TrendWindow::LastHour ? "last hour" : "last day",
+                    TOP_K, overlap, k, overcount * 100.0);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef ADJACENCY_SET_H
+#define ADJACENCY_SET_H
+
+#include "id_interner.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+// Read-only view of a contiguous run of user indexes. Valid until the
+// set it came from is modified.
+class IdView {
+private:
+    const UserIdx* first;
+    size_t count;
+
+public:
+    IdView() : first(nullptr), count(0) {}
+    IdView(const UserIdx* data, size_t size) : first(data), count(size) {}
+
+    const UserIdx* begin() const { return first; }
+    const UserIdx* end() const { return first + count; }
+    const UserIdx* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    UserIdx operator[](size_t i) const { return first[i]; }
+};
+
+// Text form of edge and liker lists: comma-separated user IDs
+void appendUserIDList(std::string& out, IdView ids);
+void splitUserIDList(std::string_view list, std::vector<UserIdx>& dst);
+
+// Set of user indexes for follower/following edges. Small sets are a flat
+// sorted vector (binary search, memmove on insert/erase). Past
+// LARGE_THRESHOLD the members stay in a vector, in no particular order,
+// and a hash index gives O(1) lookup and swap-and-pop removal. Either way
+// the members are contiguous, so views need no copy.
+class AdjacencySet {
+private:
+    std::vector<UserIdx> items;
+    std::unordered_map<UserIdx, uint32_t> position;   // only used when large
+    bool large;
+
+    void promote();
+    void demote();
+
+public:
+    static const size_t LARGE_THRESHOLD = 256;
+    static const size_t SMALL_THRESHOLD = 128;   // shrink back below this
+
+    AdjacencySet() : large(false) {}
+
+    bool insert(UserIdx idx);
+    bool erase(UserIdx idx);
+    bool contains(UserIdx idx) const;
+
+    // Replace the contents in one go (duplicates are dropped)
+    void assign(std::vector<UserIdx> ids);
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    bool isLarge() const { return large; }
+    IdView view() const { return IdView(items.data(), items.size()); }
+};
+
+#endif // ADJACENCY_SET_H
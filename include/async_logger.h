@@ -0,0 +1,123 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+// What a caller does when the ring is full
+enum class OverflowPolicy {
+    Drop,   // DEBUG and INFO messages are counted and dropped; WARNING and ERROR wait
+    Block   // every message waits for room
+};
+
+struct LoggerStats {
+    uint64_t written = 0;
+    uint64_t dropped = 0;
+};
+
+// Logger behind log(). Callers copy the message into a fixed ring of slots
+// (lock-free, many producers, one consumer) and return; a background thread
+// formats timestamps (cached per second), appends to data/logs.txt through a
+// handle that stays open, and echoes to the console. Slots keep their string
+// buffers, so a steady stream of messages allocates nothing.
+//
+// Created on first use and drained by an atexit hook; anything logged after
+// that is written synchronously.
+class AsyncLogger {
+public:
+    static const size_t CAPACITY = 8192;    // power of two
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        uint64_t timestamp;
+        std::string message;
+    };
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> tail;       // next slot a producer claims
+    alignas(64) size_t head;                    // next slot the writer reads
+    std::atomic<size_t> activeProducers;
+
+    std::atomic<LogLevel> minLevel;
+    std::atomic<OverflowPolicy> overflowPolicy;
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> dropped;
+    uint64_t droppedReported;
+
+    // Writer thread state
+    std::thread writer;
+    std::atomic<bool> running;
+    std::atomic<bool> writerSleeping;
+    std::atomic<bool> writerExited;
+    std::atomic<size_t> flushWaiters;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+
+    FILE* file;
+    std::chrono::steady_clock::time_point lastOpenAttempt;
+    uint64_t cachedSecond;
+    std::string cachedTime;
+    std::string fileBuffer;
+    std::string consoleBuffer;
+    std::mutex directMutex;     // keeps lines whole on the synchronous path
+
+    static AsyncLogger* instance;
+    static std::mutex instanceMutex;
+
+    AsyncLogger();
+
+    bool tryPush(LogLevel level, uint64_t timestamp, const std::string& message);
+    void wakeWriter();
+    void writerLoop();
+    size_t drain();
+    void formatLine(LogLevel level, uint64_t timestamp, const std::string& message);
+    void writeBuffers();
+    bool ensureFile();
+    void writeDirect(LogLevel level, uint64_t timestamp, const std::string& message);
+    static void shutdownAtExit();
+
+public:
+    ~AsyncLogger();
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    static AsyncLogger& getInstance();
+
+    // "DEBUG", "INFO", "WARNING" or "ERROR"; anything else counts as INFO
+    static LogLevel parseLevel(const std::string& name);
+    static const char* levelName(LogLevel level);
+
+    void write(LogLevel level, const std::string& message);
+
+    // Messages below the minimum level are discarded by the caller
+    void setMinLevel(LogLevel level);
+    LogLevel getMinLevel() const;
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    // Block until everything logged before the call has been written
+    void flush();
+
+    // Drain the ring and stop the writer; later messages are written inline
+    void shutdown();
+
+    LoggerStats getStats() const;
+};
+
+#endif // ASYNC_LOGGER_H
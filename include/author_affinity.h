@@ -0,0 +1,53 @@
+#ifndef AUTHOR_AFFINITY_H
+#define AUTHOR_AFFINITY_H
+
+#include "id_interner.h"
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// How often each user has liked each author's posts: the reverse tally of
+// LikeIndex, used by feed ranking to favour authors a reader engages with.
+// A user's tally is a small vector sorted by author; users who never liked
+// anything take no space. Users are spread over lock shards the same way
+// LikeIndex spreads posts.
+class AuthorAffinity {
+public:
+    static const size_t SHARDS = 64;
+
+    struct Entry {
+        UserIdx author;
+        uint32_t likes;
+    };
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<UserIdx, std::vector<Entry>> byUser;
+    };
+    Shard shards[SHARDS];
+
+    Shard& shardFor(UserIdx user) { return shards[user % SHARDS]; }
+    const Shard& shardFor(UserIdx user) const { return shards[user % SHARDS]; }
+
+public:
+    AuthorAffinity() = default;
+    AuthorAffinity(const AuthorAffinity&) = delete;
+    AuthorAffinity& operator=(const AuthorAffinity&) = delete;
+
+    // Count one more like by user on a post by author
+    void add(UserIdx user, UserIdx author);
+
+    // Replace everything with one (user, author) pair per like
+    void bulkLoad(std::vector<std::pair<UserIdx, UserIdx>> likes);
+
+    // Copy of the user's tally, sorted by author
+    void copyFor(UserIdx user, std::vector<Entry>& out) const;
+
+    void clear();
+};
+
+#endif // AUTHOR_AFFINITY_H
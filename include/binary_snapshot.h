@@ -0,0 +1,102 @@
+#ifndef BINARY_SNAPSHOT_H
+#define BINARY_SNAPSHOT_H
+
+#include "user.h"
+#include "post.h"
+#include "social_graph.h"
+#include "like_index.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Binary snapshot layout (host byte order, all offsets from file start):
+//
+//   SnapshotHeader
+//   SnapshotUserRecord[userCount]
+//   SnapshotPostRecord[postCount]
+//   uint32_t edges[edgeCount]     follower/following and liker lists as user-table indexes
+//   char blob[blobSize]           every string, referenced by SnapshotStrRef
+//
+// Records are fixed width so the loader can walk the mapped file directly
+// without tokenizing or decoding anything. Version 1 files (post records
+// without liker lists) are still read.
+
+const char SNAPSHOT_MAGIC[8] = {'S', 'M', 'F', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t userCount;
+    uint64_t postCount;
+    uint64_t userTableOffset;
+    uint64_t postTableOffset;
+    uint64_t edgeOffset;
+    uint64_t edgeCount;
+    uint64_t blobOffset;
+    uint64_t blobSize;
+};
+
+// Slice of the string blob
+struct SnapshotStrRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct SnapshotUserRecord {
+    SnapshotStrRef userID;
+    SnapshotStrRef username;
+    SnapshotStrRef name;
+    SnapshotStrRef bio;
+    uint32_t followersBegin;
+    uint32_t followersCount;
+    uint32_t followingBegin;
+    uint32_t followingCount;
+};
+
+struct SnapshotPostRecord {
+    SnapshotStrRef postID;
+    SnapshotStrRef userID;
+    SnapshotStrRef content;
+    uint64_t timestamp;
+    int32_t likes;
+    uint32_t likersBegin;
+    uint32_t likersCount;
+    uint32_t reserved;
+};
+
+struct SnapshotPostRecordV1 {
+    SnapshotStrRef postID;
+    SnapshotStrRef userID;
+    SnapshotStrRef content;
+    uint64_t timestamp;
+    int32_t likes;
+    uint32_t reserved;
+};
+
+class BinarySnapshot {
+public:
+    // Serialize to path via temp file + rename. The temp file is synced
+    // before the rename and the directory after it, so once this returns
+    // true the new snapshot survives a power loss. False on any I/O or
+    // sync error.
+    // Like counts are taken from likes, not from the (live) post records.
+    static bool write(const std::string& path,
+                      const std::vector<std::shared_ptr<const User>>& userView,
+                      const std::vector<std::shared_ptr<const Post>>& postView,
+                      const SocialGraph& graph,
+                      const LikeView& likes,
+                      uint64_t& bytesWritten);
+
+    // Map path and rebuild records; follow edges come back as
+    // (follower, followee) pairs and likes as (post, user) pairs. Throws
+    // std::runtime_error on a corrupt file. Returns false if the file does
+    // not exist.
+    static bool load(const std::string& path, std::vector<User>& usersOut, std::vector<Post>& postsOut,
+                     std::vector<std::pair<UserIdx, UserIdx>>& followsOut,
+                     std::vector<std::pair<PostIdx, UserIdx>>& likesOut);
+};
+
+#endif // BINARY_SNAPSHOT_H
@@ -0,0 +1,65 @@
+#ifndef COUNT_MIN_SKETCH_H
+#define COUNT_MIN_SKETCH_H
+
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-size frequency sketch: DEPTH rows of `width` counters, one counter
+// per row for each key. An estimate is the smallest of the key's counters,
+// so it never undercounts and overcounts by at most about
+// e * total / width with high probability. Sketches of the same width can
+// be subtracted, which lets a sliding window drop an expired bucket.
+class CountMinSketch {
+public:
+    static const size_t DEPTH = 4;
+
+private:
+    size_t mask;                    // width - 1; width is a power of two
+    std::vector<uint32_t> cells;    // DEPTH rows of width counters
+
+    // Row i uses h1 + i * h2 (double hashing from one 64-bit hash)
+    size_t cell(size_t row, uint64_t hash) const {
+        uint32_t h1 = static_cast<uint32_t>(hash);
+        uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+        return row * (mask + 1) + ((h1 + row * h2) & mask);
+    }
+
+public:
+    explicit CountMinSketch(size_t width = 1024) : mask(1) {
+        while (mask + 1 < width) mask = (mask << 1) | 1;
+        cells.assign(DEPTH * (mask + 1), 0);
+    }
+
+    // 64-bit FNV-1a, the key hash callers pass in
+    static uint64_t hash(std::string_view key) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    void add(uint64_t hash, uint32_t count = 1) {
+        for (size_t row = 0; row < DEPTH; ++row) cells[cell(row, hash)] += count;
+    }
+
+    uint32_t estimate(uint64_t hash) const {
+        uint32_t best = UINT32_MAX;
+        for (size_t row = 0; row < DEPTH; ++row) best = std::min(best, cells[cell(row, hash)]);
+        return best;
+    }
+
+    // Remove counts that were added to this sketch and to other
+    void subtract(const CountMinSketch& other) {
+        for (size_t i = 0; i < cells.size(); ++i) cells[i] -= other.cells[i];
+    }
+
+    void clear() { std::fill(cells.begin(), cells.end(), 0); }
+    size_t memoryBytes() const { return cells.capacity() * sizeof(uint32_t); }
+};
+
+#endif // COUNT_MIN_SKETCH_H
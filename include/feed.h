@@ -3,48 +3,52 @@
 
 #include "Post.h"
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <iostream>
 
-// Abstract Feed Interface
+// Abstract Feed Interface. Feeds hold handles to the stored posts, so
+// adding, sorting and reading never copy a record.
 struct IFeed {
-    virtual void addPost(const Post& p) = 0;
-    virtual std::vector<Post> getFeed() const = 0;
+    virtual void addPost(PostRef p) = 0;
+    virtual const std::vector<PostRef>& getFeed() const = 0;
     virtual void sortByTimestamp(bool desc = true) = 0;
     virtual void sortByLikes(bool desc = true) = 0;
     virtual void clear() = 0;
     virtual ~IFeed() = default;
 };
 
-// Template-based Feed Implementation
+// Template-based Feed Implementation. Sorting moves the handles only.
 template<typename T>
 class TextFeed : public IFeed {
 private:
-    std::vector<T> posts;
+    using Ref = std::shared_ptr<const T>;
+    std::vector<Ref> posts;
 
 public:
     // Add post to feed
-    void addPost(const T& p) override {
-        posts.push_back(p);
+    void addPost(Ref p) override {
+        if (p) posts.push_back(std::move(p));
+    }
+
+    void addPosts(const std::vector<Ref>& refs) {
+        posts.reserve(posts.size() + refs.size());
+        for (const Ref& p : refs) addPost(p);
     }
 
     // Get all posts
-    std::vector<Post> getFeed() const override {
-        std::vector<Post> result;
-        for (const auto& p : posts) {
-            result.push_back(p);
-        }
-        return result;
+    const std::vector<Ref>& getFeed() const override {
+        return posts;
     }
 
     // Sort by timestamp (newest first by default)
     void sortByTimestamp(bool desc = true) override {
         if (desc) {
             std::sort(posts.begin(), posts.end(), 
-                [](const T& a, const T& b) { return a.getTimestamp() > b.getTimestamp(); });
+                [](const Ref& a, const Ref& b) { return a->getTimestamp() > b->getTimestamp(); });
         } else {
             std::sort(posts.begin(), posts.end(), 
-                [](const T& a, const T& b) { return a.getTimestamp() < b.getTimestamp(); });
+                [](const Ref& a, const Ref& b) { return a->getTimestamp() < b->getTimestamp(); });
         }
     }
 
@@ -52,10 +56,10 @@ public:
     void sortByLikes(bool desc = true) override {
         if (desc) {
             std::sort(posts.begin(), posts.end(), 
-                [](const T& a, const T& b) { return a.getLikes() > b.getLikes(); });
+                [](const Ref& a, const Ref& b) { return a->getLikes() > b->getLikes(); });
         } else {
             std::sort(posts.begin(), posts.end(), 
-                [](const T& a, const T& b) { return a.getLikes() < b.getLikes(); });
+                [](const Ref& a, const Ref& b) { return a->getLikes() < b->getLikes(); });
         }
     }
 
@@ -73,7 +77,7 @@ public:
 
         std::cout << "\n═══════════════ FEED ═══════════════\n";
         for (const auto& post : posts) {
-            post.display();
+            post->display();
             std::cout << "────────────────────────────────────\n";
         }
     }
@@ -0,0 +1,112 @@
+#ifndef FEED_RANKER_H
+#define FEED_RANKER_H
+
+#include "id_interner.h"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstddef>
+#include <cstdint>
+
+// Candidate posts for one ranked feed, newest first, with one contiguous
+// array per feature. Scorers read the features by position, so a scoring
+// pass is a straight loop over a few float arrays.
+struct FeedCandidates {
+    std::vector<PostIdx> posts;
+    std::vector<float> ageHours;    // time since posting, never negative
+    std::vector<float> likes;
+    std::vector<float> affinity;    // the reader's past likes on the author
+
+    size_t size() const { return posts.size(); }
+    void clear() {
+        posts.clear();
+        ageHours.clear();
+        likes.clear();
+        affinity.clear();
+    }
+    void resize(size_t n) {
+        posts.resize(n);
+        ageHours.resize(n);
+        likes.resize(n);
+        affinity.resize(n);
+    }
+};
+
+// ---------------------- Scorers ----------------------
+// A scorer is any type with `float operator()(const FeedCandidates&, size_t)
+// const`; higher scores rank first. They are template arguments, not virtual
+// calls, so the per-candidate code is inlined into the scoring loop.
+
+// Newer is better; the score halves after halfLifeHours
+struct RecencyScorer {
+    float halfLifeHours = 24.0f;
+
+    float operator()(const FeedCandidates& c, size_t i) const {
+        return 1.0f / (1.0f + c.ageHours[i] / halfLifeHours);
+    }
+};
+
+// Likes per unit of age, with gravity so old posts sink despite their likes
+struct LikeVelocityScorer {
+    float offsetHours = 2.0f;
+
+    float operator()(const FeedCandidates& c, size_t i) const {
+        float t = c.ageHours[i] + offsetHours;
+        return c.likes[i] / (t * t);
+    }
+};
+
+// Authors the reader has liked before; saturates towards 1
+struct AuthorAffinityScorer {
+    float halfAtLikes = 3.0f;
+
+    float operator()(const FeedCandidates& c, size_t i) const {
+        return c.affinity[i] / (c.affinity[i] + halfAtLikes);
+    }
+};
+
+// Weighted blend of the three signals
+struct EngagementScorer {
+    RecencyScorer recency;
+    LikeVelocityScorer velocity;
+    AuthorAffinityScorer affinity;
+    float recencyWeight = 1.0f;
+    float velocityWeight = 4.0f;
+    float affinityWeight = 0.5f;
+
+    float operator()(const FeedCandidates& c, size_t i) const {
+        return recencyWeight * recency(c, i) +
+               velocityWeight * velocity(c, i) +
+               affinityWeight * affinity(c, i);
+    }
+};
+
+// ---------------------- Ranking ----------------------
+// Score every candidate, then select the best k with nth_element and sort
+// only those. order receives candidate positions, best first; equal scores
+// keep the newer post first. scores and order are scratch space the caller
+// may reuse across calls.
+template<typename Scorer>
+void rankCandidates(const FeedCandidates& c, const Scorer& scorer, size_t k,
+                    std::vector<float>& scores, std::vector<uint32_t>& order) {
+    const size_t n = c.size();
+    scores.resize(n);
+    float* out = scores.data();
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = scorer(c, i);
+    }
+
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0u);
+    auto better = [out](uint32_t a, uint32_t b) {
+        return out[a] != out[b] ? out[a] > out[b] : a < b;
+    };
+    k = std::min(k, n);
+    if (k < n) {
+        std::nth_element(order.begin(), order.begin() + k, order.end(), better);
+        order.resize(k);
+    }
+    std::sort(order.begin(), order.end(), better);
+}
+
+#endif // FEED_RANKER_H
@@ -0,0 +1,59 @@
+#ifndef FIELD_PARSER_H
+#define FIELD_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+// Allocation-free helpers for the record load path. Fields are returned as
+// views into the caller's line; decoding writes into a caller-owned buffer.
+
+// First occurrence of c in [p, end), or end. Uses AVX2/SSE2 when the build
+// enables them and a scalar loop otherwise.
+const char* findByte(const char* p, const char* end, char c);
+
+// Number of occurrences of c in s (same vector paths as findByte)
+size_t countByte(std::string_view s, char c);
+
+// Walks delimiter-separated fields of a line without copying.
+// "a||b" yields "a", "", "b"; an empty line yields one empty field.
+class FieldTokenizer {
+private:
+    const char* pos;
+    const char* end;
+    char delim;
+    bool done;
+
+public:
+    FieldTokenizer(std::string_view s, char d)
+        : pos(s.data()), end(s.data() + s.size()), delim(d), done(false) {}
+
+    bool next(std::string_view& field) {
+        if (done) return false;
+        const char* hit = findByte(pos, end, delim);
+        field = std::string_view(pos, static_cast<size_t>(hit - pos));
+        if (hit == end) {
+            done = true;
+        } else {
+            pos = hit + 1;
+        }
+        return true;
+    }
+};
+
+// Fill out[0..maxFields) with the leading fields of s; returns how many were found
+size_t splitFields(std::string_view s, char delim, std::string_view* out, size_t maxFields);
+
+// Decode %xx escapes from in into out (which needs in.size() bytes and may
+// alias in). Malformed escapes are copied through. Returns bytes written.
+size_t percentDecodeInto(std::string_view in, char* out);
+
+// Decode into dst, reusing its capacity
+void percentDecode(std::string_view in, std::string& dst);
+
+// Strict decimal parsing of a whole field
+bool parseUint64(std::string_view s, uint64_t& value);
+bool parseInt(std::string_view s, int& value);
+
+#endif // FIELD_PARSER_H
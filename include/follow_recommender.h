@@ -0,0 +1,65 @@
+#ifndef FOLLOW_RECOMMENDER_H
+#define FOLLOW_RECOMMENDER_H
+
+#include "id_interner.h"
+#include "social_graph.h"
+#include "author_affinity.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+struct FollowSuggestion {
+    UserIdx user;
+    uint32_t mutuals;       // sampled followees of the reader who follow user
+    float score;
+};
+
+// Friend-of-friend suggestions: walks the reader's followees and their
+// followees, scoring each account reached by the number of paths to it.
+// Accounts the reader already follows are skipped.
+//
+// Work is bounded for large accounts: at most MAX_FOLLOWING of the reader's
+// followees are walked, and at most MAX_FANOUT of each one's followees.
+// Longer lists are sampled at an even stride from an offset fixed by the
+// reader, so repeated queries agree, and each sampled path is weighted by
+// list length / sample size to keep scores comparable with full lists.
+//
+// With an AuthorAffinity, engagement counts too: paths through authors the
+// reader has liked weigh more, and candidates the reader has liked get a
+// bonus of their own.
+//
+// An instance is only scratch space: arrays indexed by UserIdx that are
+// allocated once and reset after each query, so keep one per thread and
+// reuse it. Not synchronized: callers keep the graph unchanged while it
+// runs.
+class FollowRecommender {
+public:
+    static constexpr size_t MAX_FOLLOWING = 256;
+    static constexpr size_t MAX_FANOUT = 512;
+    static constexpr float ENGAGEMENT_WEIGHT = 0.5f;
+
+private:
+    struct Tally {
+        float score;
+        uint32_t mutuals;
+    };
+
+    std::vector<Tally> tallies;         // by UserIdx, zero outside a query
+    std::vector<UserIdx> touched;
+    std::vector<UserIdx> following;     // all of the reader's followees
+    std::vector<UserIdx> sources;       // the ones walked
+    std::vector<UserIdx> fanout;
+    std::vector<AuthorAffinity::Entry> engagement;
+
+    Tally& tallyFor(UserIdx idx);
+    uint32_t likesOf(UserIdx author) const;
+    static void sample(std::vector<UserIdx>& list, size_t limit, uint64_t seed);
+
+public:
+    // Up to k suggestions for user, best first (ties by lower index).
+    // affinity may be null to rank by mutual follows alone.
+    void recommend(const SocialGraph& graph, const AuthorAffinity* affinity,
+                   UserIdx user, size_t k, std::vector<FollowSuggestion>& out);
+};
+
+#endif // FOLLOW_RECOMMENDER_H
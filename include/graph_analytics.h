@@ -0,0 +1,57 @@
+#ifndef GRAPH_ANALYTICS_H
+#define GRAPH_ANALYTICS_H
+
+#include "id_interner.h"
+#include "social_graph.h"
+#include "thread_pool.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Users by degree in power-of-two buckets: bucket 0 holds degree 0 and
+// bucket b holds degrees [2^(b-1), 2^b)
+struct DegreeHistogram {
+    std::vector<uint64_t> buckets;
+    uint32_t maxDegree = 0;
+    UserIdx maxUser = 0;        // a user with maxDegree
+    double mean = 0.0;
+
+    static uint32_t bucketLow(size_t b) { return b == 0 ? 0 : 1u << (b - 1); }
+    static uint32_t bucketHigh(size_t b) { return b == 0 ? 0 : (1u << b) - 1; }
+};
+
+struct GraphSummary {
+    size_t users = 0;           // vertices scanned, including unused slots
+    size_t edges = 0;
+    size_t reciprocalPairs = 0; // pairs who follow each other
+    double reciprocity = 0.0;   // share of edges that are followed back
+    DegreeHistogram following;
+    DegreeHistogram followers;
+};
+
+// Read-only analytics over a SocialGraph. Every function reads through the
+// graph's const API, so it may run on a copy of the graph (copies share
+// the CSR arrays) while the original keeps taking edits. vertexCount bounds
+// the user indexes that appear in the graph.
+
+// Degree histograms and reciprocal follows. Users are split into ranges
+// scanned on the pool; reciprocal pairs come from intersecting each
+// user's following and follower lists.
+GraphSummary summarizeGraph(const SocialGraph& graph, size_t vertexCount, ThreadPool& pool);
+
+// Users who follow both a and b, in index order
+void mutualFollowers(const SocialGraph& graph, UserIdx a, UserIdx b, std::vector<UserIdx>& out);
+
+// Hops on the shortest follow path from -> to, or -1 if there is none within
+// maxDepth. Searches forward from one end and backward from the other,
+// always widening the smaller frontier. Frontiers and visited sets are
+// bitsets; large frontiers are expanded on the pool.
+int degreesOfSeparation(const SocialGraph& graph, size_t vertexCount, UserIdx from, UserIdx to,
+                        int maxDepth, ThreadPool& pool);
+
+// counts[d] = users first reached in d hops along follow edges, d = 1..maxDepth
+// (counts[0] is 1, the user itself). Stops early when nothing new is reached.
+void reachByDistance(const SocialGraph& graph, size_t vertexCount, UserIdx from, int maxDepth,
+                     ThreadPool& pool, std::vector<size_t>& counts);
+
+#endif // GRAPH_ANALYTICS_H
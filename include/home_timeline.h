@@ -0,0 +1,87 @@
+#ifndef HOME_TIMELINE_H
+#define HOME_TIMELINE_H
+
+#include "id_interner.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Feed order: timestamp, ties broken by PostIdx
+struct FeedKey {
+    uint64_t timestamp;
+    PostIdx idx;
+};
+
+inline bool olderThan(const FeedKey& a, const FeedKey& b) {
+    return a.timestamp < b.timestamp || (a.timestamp == b.timestamp && a.idx < b.idx);
+}
+
+// How feeds are assembled
+enum class FeedStrategy {
+    FanOutOnRead,   // merge followees' posts at read time
+    FanOutOnWrite,  // push every new post into followers' timelines
+    Hybrid          // push, except for authors at or above the celebrity threshold
+};
+
+// Bounded home timeline of one user: a ring of post handles, oldest to
+// newest. When full, a push overwrites the oldest entry and the timeline
+// is marked truncated (older posts must then come from the author index).
+// A stale timeline is rebuilt on its next read.
+class HomeTimeline {
+private:
+    std::vector<PostIdx> slots;
+    size_t head;        // position of the oldest entry
+    size_t count;
+    bool stale;
+    bool truncated;
+
+public:
+    HomeTimeline() : head(0), count(0), stale(true), truncated(false) {}
+
+    void reset(size_t capacity) {
+        slots.assign(capacity, INVALID_IDX);
+        head = 0;
+        count = 0;
+        stale = false;
+        truncated = false;
+    }
+
+    // Append a post newer than every entry already present
+    void push(PostIdx idx) {
+        if (slots.empty()) {
+            truncated = true;
+            return;
+        }
+        if (count < slots.size()) {
+            slots[(head + count) % slots.size()] = idx;
+            count++;
+        } else {
+            slots[head] = idx;
+            head = (head + 1) % slots.size();
+            truncated = true;
+        }
+    }
+
+    void markStale() { stale = true; }
+    void markTruncated() { truncated = true; }
+    bool isStale() const { return stale; }
+    bool isTruncated() const { return truncated; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    PostIdx oldest() const { return slots[head]; }
+    PostIdx newest() const { return slots[(head + count - 1) % slots.size()]; }
+
+    // The ring as two contiguous runs, each oldest to newest; the first
+    // run is entirely older than the second
+    const PostIdx* firstRun(size_t& length) const {
+        length = (head + count <= slots.size()) ? count : slots.size() - head;
+        return slots.data() + head;
+    }
+    const PostIdx* secondRun(size_t& length) const {
+        length = (head + count <= slots.size()) ? 0 : head + count - slots.size();
+        return slots.data();
+    }
+};
+
+#endif // HOME_TIMELINE_H
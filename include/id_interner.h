@@ -0,0 +1,44 @@
+#ifndef ID_INTERNER_H
+#define ID_INTERNER_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include "sharded_shared_mutex.h"
+#include <cstdint>
+
+// Dense 32-bit handles for user and post IDs ("u_1000", "p_1005")
+using UserIdx = uint32_t;
+using PostIdx = uint32_t;
+const uint32_t INVALID_IDX = UINT32_MAX;
+
+// Bidirectional string <-> index table. Indexes are handed out in insertion
+// order and never reused, so they can index plain vectors. Safe to share
+// between threads; looking up a known ID only takes a shared lock, on the
+// caller's own shard since every core API call resolves IDs here.
+class IdInterner {
+private:
+    std::deque<std::string> names;   // deque keeps addresses stable for the views below
+    std::unordered_map<std::string_view, uint32_t> indexOf;
+    mutable ShardedSharedMutex tableMutex;
+
+public:
+    // Index for id, adding it if it is new
+    uint32_t intern(std::string_view id);
+
+    // Index for id, or INVALID_IDX if it was never interned
+    uint32_t find(std::string_view id) const;
+
+    // String for idx (empty for INVALID_IDX); the reference stays valid
+    const std::string& name(uint32_t idx) const;
+
+    size_t size() const;
+    void reserve(size_t count);
+};
+
+// Process-wide tables; strings only exist here and at the API/file boundary
+IdInterner& userIdTable();
+IdInterner& postIdTable();
+
+#endif // ID_INTERNER_H
@@ -0,0 +1,77 @@
+#ifndef INBOX_STORE_H
+#define INBOX_STORE_H
+
+#include "id_interner.h"
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// Memory used by the notification inboxes
+struct InboxStats {
+    size_t users = 0;           // inbox headers
+    size_t activeInboxes = 0;   // users holding a ring
+    size_t slabs = 0;
+    size_t bytes = 0;           // headers plus slabs
+};
+
+// Per-user notification inboxes: a ring of the newest post handles plus an
+// unread count. A user costs a 12-byte header until the first notification
+// arrives; rings are then carved out of shared slabs (SLAB_RINGS rings per
+// allocation) and handed back to a free list on reset.
+//
+// Every inbox counts pushes and remembers the count at the last mark-read,
+// so marking read is a single store and the unread count a subtraction.
+// Only the newest `capacity` entries are kept; older ones fall off the ring.
+// The capacity is rounded up to a power of two so the counters can wrap.
+//
+// Not synchronized: callers serialize writers and readers of one user.
+class InboxStore {
+public:
+    static const size_t DEFAULT_CAPACITY = 64;
+    static const size_t SLAB_RINGS = 256;
+
+private:
+    struct Header {
+        uint32_t ring;      // ring number, or NO_RING
+        uint32_t pushed;    // notifications ever delivered (wraps)
+        uint32_t seen;      // value of pushed at the last mark-read
+    };
+    static const uint32_t NO_RING = UINT32_MAX;
+
+    size_t capacity;
+    std::vector<Header> headers;                // indexed by UserIdx
+    std::vector<std::unique_ptr<PostIdx[]>> slabs;
+    std::vector<uint32_t> freeRings;
+    uint32_t ringCount;
+
+    PostIdx* ringData(uint32_t ring) const {
+        return slabs[ring / SLAB_RINGS].get() + (ring % SLAB_RINGS) * capacity;
+    }
+    uint32_t allocateRing();
+
+public:
+    explicit InboxStore(size_t ringCapacity = DEFAULT_CAPACITY);
+
+    // Make room for users up to and including idx
+    void ensureUser(UserIdx idx);
+
+    void push(UserIdx user, PostIdx post);
+
+    size_t unreadCount(UserIdx user) const;
+    size_t size(UserIdx user) const;
+
+    // Newest first, at most limit entries; unreadOnly stops at the read mark
+    void recent(UserIdx user, size_t limit, bool unreadOnly, std::vector<PostIdx>& out) const;
+
+    void markAllRead(UserIdx user);
+
+    // Drop the user's entries and return the ring to the free list
+    void reset(UserIdx user);
+
+    void clear();
+    size_t getCapacity() const { return capacity; }
+    InboxStats stats() const;
+};
+
+#endif // INBOX_STORE_H
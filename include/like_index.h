@@ -0,0 +1,63 @@
+#ifndef LIKE_INDEX_H
+#define LIKE_INDEX_H
+
+#include "id_interner.h"
+#include "adjacency_set.h"
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Like counts and likers copied at one instant, for snapshot writers that
+// run while new likes keep landing on the live records
+struct LikeView {
+    std::vector<int32_t> counts;                                // by PostIdx
+    std::unordered_map<PostIdx, std::vector<UserIdx>> likers;   // sorted lists
+
+    int32_t count(PostIdx post) const { return (post < counts.size()) ? counts[post] : 0; }
+    IdView likersOf(PostIdx post) const {
+        auto it = likers.find(post);
+        return (it != likers.end()) ? IdView(it->second.data(), it->second.size()) : IdView();
+    }
+};
+
+// Who liked which post, so a user can like a post only once. Each post's
+// likers are an AdjacencySet; posts nobody has liked take no space. The
+// posts are spread over lock shards, so likes on different posts rarely
+// wait for each other. Like counts themselves live on the Post records.
+class LikeIndex {
+public:
+    static const size_t SHARDS = 64;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<PostIdx, AdjacencySet> likers;
+    };
+    Shard shards[SHARDS];
+
+    Shard& shardFor(PostIdx post) { return shards[post % SHARDS]; }
+    const Shard& shardFor(PostIdx post) const { return shards[post % SHARDS]; }
+
+public:
+    LikeIndex() = default;
+    LikeIndex(const LikeIndex&) = delete;
+    LikeIndex& operator=(const LikeIndex&) = delete;
+
+    // Record a like; false if the user already liked the post
+    bool add(PostIdx post, UserIdx user);
+    bool contains(PostIdx post, UserIdx user) const;
+
+    // Replace everything with (post, user) pairs; duplicates are dropped
+    void bulkLoad(std::vector<std::pair<PostIdx, UserIdx>> likes);
+
+    // Copy of every post's likers, each list sorted
+    void copyTo(std::unordered_map<PostIdx, std::vector<UserIdx>>& out) const;
+
+    size_t size() const;
+    void clear();
+};
+
+#endif // LIKE_INDEX_H
@@ -0,0 +1,114 @@
+#ifndef MUTATION_LOG_H
+#define MUTATION_LOG_H
+
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+// Kinds of state change recorded in the mutation log
+enum class MutationType : char {
+    AddUser     = 'U',
+    AddPost     = 'P',
+    Follow      = 'F',
+    Unfollow    = 'X',
+    Like        = 'L',    // absolute count, written by older builds
+    LikedBy     = 'K',
+    EditPost    = 'E',
+    EditProfile = 'R'
+};
+
+// When committed records are forced to stable storage
+enum class FsyncPolicy {
+    Never,        // flush to the OS only, let it decide when to write back
+    EveryCommit,  // fsync once per group commit
+    Interval      // fsync at most once per configured interval
+};
+
+// One log record: type tag plus a pipe-delimited payload
+// Line format: <type>|<payload>
+struct Mutation {
+    MutationType type;
+    std::string payload;
+
+    std::string serialize() const;
+    static Mutation deserialize(const std::string& line);
+};
+
+// Append-only, durable mutation log with group commit.
+// Writers append records under their own lock and later call commit();
+// the first committer writes and syncs the whole pending batch for everyone.
+// A batch whose write fails is cut back out of the file and queued again,
+// so the next commit retries it; a failed sync is retried the same way.
+// rotate() moves the live log aside as an archive segment so a snapshot can
+// be written while new records keep landing in a fresh file.
+class MutationLog {
+private:
+    std::string path;
+    std::string archivePath;
+    FILE* file;
+    uint64_t fileBytes;
+
+    std::mutex logMutex;
+    std::condition_variable flushed;
+    std::string pending;      // serialized records not yet written
+    uint64_t appendedSeq;     // last sequence number handed out
+    uint64_t durableSeq;      // last sequence number written (and synced per policy)
+    uint64_t failedSeq;       // last sequence number of the latest failed batch
+    bool flushing;            // a leader is currently writing a batch
+    bool syncOwed;            // a sync failed; retry it on the next commit
+    bool dirSyncOwed;         // the live segment's directory entry is not yet synced
+
+    FsyncPolicy policy;
+    std::chrono::milliseconds syncInterval;
+    std::chrono::steady_clock::time_point lastSync;
+
+    bool syncFile();
+    bool syncDirectory();
+    bool writeBatch(const std::string& batch, bool forceSync);
+    static bool trimTornTail(const std::string& filePath);
+    static size_t replayFile(const std::string& filePath, const std::function<void(const Mutation&)>& apply);
+
+public:
+    explicit MutationLog(const std::string& logPath);
+    ~MutationLog();
+
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    // Open (or create) the log for appending. Call after replay: a torn
+    // final record left by a crash is cut off first, so new records don't
+    // land on the end of it.
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    // Durability configuration
+    void setFsyncPolicy(FsyncPolicy p, std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+    // Buffer a record; returns its sequence number for commit()
+    uint64_t append(const Mutation& m);
+
+    // Block until every record up to seq has been written. False if the
+    // batch holding seq could not be written or synced (it stays queued).
+    bool commit(uint64_t seq);
+
+    // Read back every complete record (archive first); returns the number applied
+    size_t replay(const std::function<void(const Mutation&)>& apply) const;
+
+    // Move everything logged so far into the archive segment and start a fresh log
+    bool rotate();
+
+    // Delete the archive once a snapshot containing its records is in place
+    void dropArchive();
+
+    // Bytes in the live log segment
+    uint64_t sizeBytes();
+
+    const std::string& getPath() const { return path; }
+};
+
+#endif // MUTATION_LOG_H
@@ -0,0 +1,86 @@
+#ifndef NOTIFICATION_DISPATCHER_H
+#define NOTIFICATION_DISPATCHER_H
+
+#include "observer.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+struct NotificationStats {
+    uint64_t enqueued = 0;      // posts accepted for delivery
+    uint64_t dropped = 0;       // posts turned away because the queue was full
+    uint64_t delivered = 0;     // posts delivered (each to all of its observers)
+    uint64_t batches = 0;
+    uint64_t observerCalls = 0; // onNotifyNewPosts calls after coalescing
+    size_t queueDepth = 0;
+    size_t maxQueueDepth = 0;
+    double avgLatencyMs = 0.0;  // enqueue to delivery done
+    double maxLatencyMs = 0.0;
+};
+
+// Delivers new-post notifications off the posting thread. addPost hands
+// over the author's notifier and the stored post; worker threads take them
+// from a bounded queue in batches. Within a batch each notifier's observer
+// list is read once, and an observer watching several authors gets all of
+// its posts in one onNotifyNewPosts call. When the queue is full the
+// notification is dropped and counted, so a slow observer never holds up
+// the writer.
+class NotificationDispatcher {
+public:
+    static const size_t DEFAULT_CAPACITY = 4096;
+    static constexpr size_t BATCH_SIZE = 64;
+
+private:
+    struct Event {
+        std::shared_ptr<PostNotifier> notifier;
+        std::shared_ptr<const Post> post;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    std::deque<Event> queue;
+    size_t capacity;
+    size_t inFlight;                // events taken by workers, not yet delivered
+    bool stopping;
+    mutable std::mutex queueMutex;
+    std::condition_variable eventReady;
+    std::condition_variable idle;
+
+    // Held shared while a batch is delivered; quiesce() takes it exclusively
+    std::shared_mutex deliveryMutex;
+
+    std::vector<std::thread> workers;
+    NotificationStats stats;
+    double totalLatencyMs;
+
+    void workerLoop();
+    void deliver(std::vector<Event>& batch);
+
+public:
+    explicit NotificationDispatcher(size_t workerCount = 2, size_t queueCapacity = DEFAULT_CAPACITY);
+    ~NotificationDispatcher();
+
+    NotificationDispatcher(const NotificationDispatcher&) = delete;
+    NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+    // Queue post for the notifier's observers; false if it was dropped.
+    // Notifiers without observers are skipped up front.
+    bool enqueue(std::shared_ptr<PostNotifier> notifier, std::shared_ptr<const Post> post);
+
+    // Wait until every queued notification has been delivered
+    void drain();
+
+    // Wait for deliveries already under way, so an observer that was just
+    // removed will not be called again. Not for use inside an observer.
+    void quiesce();
+
+    NotificationStats getStats() const;
+};
+
+#endif // NOTIFICATION_DISPATCHER_H
@@ -3,11 +3,25 @@
 
 #include "Post.h"
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 
-// Observer interface - objects that want to be notified of new posts
+// Observer interface - objects that want to be notified of new posts.
+// Delivery runs on the notification dispatcher's threads, so observers
+// must be safe to call from a thread other than the one that posted.
 class IObserver {
 public:
     virtual void onNotifyNewPost(const Post& p) = 0;
+
+    // Several posts in one call, oldest first; by default one at a time
+    virtual void onNotifyNewPosts(const std::vector<const Post*>& posts) {
+        for (const Post* p : posts) {
+            onNotifyNewPost(*p);
+        }
+    }
+
     virtual ~IObserver() = default;
 };
 
@@ -20,49 +34,75 @@ public:
     virtual ~ISubject() = default;
 };
 
-// Concrete Subject - Manages observers and notifications
+// Concrete Subject - Manages observers and notifications.
+// The observer list is copy-on-write: a delivery walks the snapshot it took,
+// so registering or removing observers never disturbs one in progress.
 class PostNotifier : public ISubject {
+public:
+    using ObserverList = std::vector<IObserver*>;
+
 private:
-    std::vector<IObserver*> observers;
+    mutable std::mutex listMutex;
+    std::shared_ptr<const ObserverList> observers;
+    std::atomic<size_t> observerCount;
 
 public:
+    PostNotifier() : observers(std::make_shared<ObserverList>()), observerCount(0) {}
+
     void registerObserver(IObserver* observer) override {
-        if (observer) {
-            observers.push_back(observer);
-        }
+        if (!observer) return;
+        std::lock_guard<std::mutex> lock(listMutex);
+        auto next = std::make_shared<ObserverList>(*observers);
+        next->push_back(observer);
+        observerCount.store(next->size());
+        observers = std::move(next);
     }
 
     void removeObserver(IObserver* observer) override {
-        auto it = std::find(observers.begin(), observers.end(), observer);
-        if (it != observers.end()) {
-            observers.erase(it);
+        std::lock_guard<std::mutex> lock(listMutex);
+        auto it = std::find(observers->begin(), observers->end(), observer);
+        if (it != observers->end()) {
+            auto next = std::make_shared<ObserverList>(*observers);
+            next->erase(next->begin() + (it - observers->begin()));
+            observerCount.store(next->size());
+            observers = std::move(next);
         }
     }
 
+    // Synchronous delivery on the caller's thread
     void notifyObservers(const Post& p) override {
-        for (auto observer : observers) {
+        for (auto observer : *snapshot()) {
             observer->onNotifyNewPost(p);
         }
     }
+
+    std::shared_ptr<const ObserverList> snapshot() const {
+        std::lock_guard<std::mutex> lock(listMutex);
+        return observers;
+    }
+
+    bool hasObservers() const {
+        return observerCount.load(std::memory_order_relaxed) > 0;
+    }
 };
 
 // Concrete Observer - User as observer (can be notified)
 class UserObserver : public IObserver {
 private:
     std::string userID;
-    int notificationCount;
+    std::atomic<int> notificationCount;
 
 public:
     UserObserver(const std::string& uid) : userID(uid), notificationCount(0) {}
 
-    void onNotifyNewPost(const Post& p) override {
+    void onNotifyNewPost(const Post&) override {
         notificationCount++;
         // In a real app, this would update a notification list
         // For now, we just track the count
     }
 
     int getNotificationCount() const {
-        return notificationCount;
+        return notificationCount.load();
     }
 
     void clearNotifications() {
@@ -0,0 +1,67 @@
+#ifndef PARALLEL_LOADER_H
+#define PARALLEL_LOADER_H
+
+#include "thread_pool.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Wall-clock cost of each startup phase, in milliseconds
+struct LoadTimings {
+    double readMs = 0.0;    // file I/O (or snapshot mapping)
+    double parseMs = 0.0;   // record decoding on the pool
+    double mergeMs = 0.0;   // inserting records into the core maps
+    double indexMs = 0.0;   // secondary structures built from the records
+    size_t records = 0;
+    size_t chunks = 0;
+};
+
+// Records parsed from one newline-aligned chunk, in file order
+template<typename T>
+struct ParsedChunk {
+    std::vector<T> records;
+    size_t failures = 0;
+    std::string firstError;
+};
+
+// Read a whole file into memory; false if it cannot be opened
+bool readWholeFile(const std::string& path, std::string& out);
+
+// Cut buffer into about targetChunks pieces that each end on a '\n'
+std::vector<std::string_view> splitChunks(std::string_view buffer, size_t targetChunks);
+
+// Parse every non-empty line of buffer with parse(std::string_view) on the
+// pool. Chunks come back in file order so later duplicates still win on merge.
+template<typename T, typename ParseFn>
+std::vector<ParsedChunk<T>> parseChunked(ThreadPool& pool, std::string_view buffer, ParseFn parse) {
+    std::vector<std::string_view> chunks = splitChunks(buffer, pool.size() * 4);
+    std::vector<ParsedChunk<T>> results(chunks.size());
+
+    parallelFor(pool, chunks.size(), [&](size_t i) {
+        std::string_view chunk = chunks[i];
+        ParsedChunk<T>& out = results[i];
+        out.records.reserve(chunk.size() / 64 + 1);
+
+        size_t pos = 0;
+        while (pos < chunk.size()) {
+            size_t end = chunk.find('\n', pos);
+            if (end == std::string_view::npos) end = chunk.size();
+            std::string_view line = chunk.substr(pos, end - pos);
+            pos = end + 1;
+
+            // Tolerate files saved with Windows line endings
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+            if (line.empty()) continue;
+            try {
+                out.records.push_back(parse(line));
+            } catch (const std::exception& e) {
+                if (out.failures++ == 0) out.firstError = e.what();
+            }
+        }
+    });
+
+    return results;
+}
+
+#endif // PARALLEL_LOADER_H
@@ -2,35 +2,58 @@
 #define POST_H
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <memory>
 #include <cstdint>
+#include "id_interner.h"
+#include "adjacency_set.h"
 
 class Post {
 private:
-    std::string postID;
-    std::string userID;
-    std::string content;
+    friend class BinarySnapshot;
+    friend class PostTable;
+
+    PostIdx idx;           // interned postID
+    UserIdx authorIdx;     // interned userID of the author
+    std::string_view content;  // in textArena()
     uint64_t timestamp;
+    // Once stored in a PostTable the like count is that table's column slot,
+    // shared by every copy of the record; until then the post keeps its own
+    std::atomic<int32_t>* likeSlot;
     int likes;
 
 public:
     // Constructors
     Post();
     Post(const std::string& pID, const std::string& uID, const std::string& cont, uint64_t ts);
+    Post(const Post& other);
+    Post(Post&& other) noexcept;
+    Post& operator=(const Post& other);
+    Post& operator=(Post&& other) noexcept;
 
-    // Getters
-    std::string getPostID() const;
-    std::string getUserID() const;
-    std::string getContent() const;
+    // Getters. IDs are the interned names and content is the arena text,
+    // so none of them copy.
+    const std::string& getPostID() const;
+    const std::string& getUserID() const;
+    PostIdx getIdx() const;
+    UserIdx getAuthorIdx() const;
+    std::string_view getContent() const;
     uint64_t getTimestamp() const;
     int getLikes() const;
+    size_t contentSize() const { return content.size(); }
 
-    // Setters & Actions
+    // Setters & Actions (atomic on a stored post, so they may race with readers)
     void like();
+    void setLikes(int count);
     void editContent(const std::string& newContent);
     
-    // Serialization
+    // Serialization. Likers are kept outside the record and passed in or
+    // out at the file boundary, together with the matching like count.
     std::string serialize() const;
-    static Post deserialize(const std::string& line);
+    std::string serialize(int likeCount, IdView likedBy) const;
+    static Post deserialize(std::string_view line, std::vector<UserIdx>* likedBy = nullptr);
     
     // Display
     void display() const;
@@ -39,4 +62,8 @@ public:
     bool operator<(const Post& other) const; // By timestamp
 };
 
+// Shared handle to a stored post. Stored records are immutable, so a handle
+// stays valid and unchanged (apart from the like count) however long it is kept.
+using PostRef = std::shared_ptr<const Post>;
+
 #endif // POST_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef POST_TABLE_H
+#define POST_TABLE_H
+
+#include "post.h"
+#include "home_timeline.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// Orderings for scans over the post table
+enum class PostOrder {
+    Newest,         // by timestamp, then PostIdx, newest first
+    MostLiked       // by like count, newest first among equal counts
+};
+
+// The hot fields of every post in separate contiguous arrays, indexed by
+// PostIdx: timestamp, author, like count and the content view. Sorting,
+// top-K and filtering scans read only the columns they need instead of
+// chasing a pointer to each record and pulling all of it into cache.
+//
+// Columns are written under the owner's exclusive lock. Like counts live in
+// fixed-size chunks of atomics, so addLike may run under a shared lock while
+// other readers scan. The likes column is the only copy of the counts:
+// store() points the record at its slot, and Post::getLikes reads through
+// it. Counters are never moved or freed (clear() zeroes them), so records
+// handed out earlier stay valid; they must not outlive the table.
+class PostTable {
+public:
+    static constexpr size_t LIKE_CHUNK = 64 * 1024;
+
+private:
+    std::vector<uint64_t> timestamps;
+    std::vector<UserIdx> authors;
+    std::vector<std::string_view> contents;     // in textArena()
+    std::vector<uint8_t> present;               // slot holds a post
+    std::vector<std::unique_ptr<std::atomic<int32_t>[]>> likeChunks;
+    size_t count;
+
+    std::atomic<int32_t>& likeSlot(PostIdx idx) const {
+        return likeChunks[idx / LIKE_CHUNK][idx % LIKE_CHUNK];
+    }
+    void grow(size_t slots);
+
+public:
+    PostTable();
+
+    void reserve(size_t slots);
+
+    // Insert the post, or overwrite its slot with the record's fields, and
+    // attach the record's like count to the column
+    void store(Post& p);
+
+    bool contains(PostIdx idx) const { return idx < present.size() && present[idx]; }
+    size_t size() const { return count; }
+    size_t slots() const { return present.size(); }
+
+    uint64_t timestamp(PostIdx idx) const { return timestamps[idx]; }
+    UserIdx author(PostIdx idx) const { return authors[idx]; }
+    std::string_view content(PostIdx idx) const { return contents[idx]; }
+    int likes(PostIdx idx) const { return likeSlot(idx).load(std::memory_order_relaxed); }
+    FeedKey key(PostIdx idx) const { return FeedKey{timestamps[idx], idx}; }
+
+    // Atomic; safe against concurrent readers and other likes
+    void addLike(PostIdx idx) { likeSlot(idx).fetch_add(1, std::memory_order_relaxed); }
+    void setLikes(PostIdx idx, int value) { likeSlot(idx).store(value, std::memory_order_relaxed); }
+
+    // Sort handles in place by the given order, keeping the first limit
+    void sort(std::vector<PostIdx>& handles, PostOrder order, size_t limit = SIZE_MAX) const;
+
+    // The first k posts of the whole table in the given order, in a single
+    // pass that keeps a k-entry heap
+    void top(size_t k, PostOrder order, std::vector<PostIdx>& out) const;
+
+    // Sum of every like count, from the likes column alone
+    uint64_t totalLikes() const;
+
+    void clear();
+    size_t memoryBytes() const;
+};
+
+#endif // POST_TABLE_H
@@ -0,0 +1,39 @@
+#ifndef POSTING_LIST_H
+#define POSTING_LIST_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Sorted set of 32-bit IDs stored as varint-encoded gaps: dense lists take
+// about one byte per entry instead of four. IDs are handed out in
+// increasing order, so adding an ID above every member is an O(1) append;
+// any other change decodes and re-encodes the list.
+class PostingList {
+private:
+    std::vector<uint8_t> bytes;
+    uint32_t count;
+    uint32_t last;      // largest member, valid when count > 0
+
+    void append(uint32_t id);
+
+public:
+    PostingList() : count(0), last(0) {}
+
+    // Replace the contents with sorted, distinct IDs
+    void assign(const std::vector<uint32_t>& ids);
+
+    // False if id was already present (add) or absent (remove)
+    bool add(uint32_t id);
+    bool remove(uint32_t id);
+
+    // Members in increasing order
+    void decode(std::vector<uint32_t>& out) const;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t memoryBytes() const { return bytes.capacity(); }
+    void shrink() { bytes.shrink_to_fit(); }
+};
+
+#endif // POSTING_LIST_H
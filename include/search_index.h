@@ -0,0 +1,88 @@
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include "id_interner.h"
+#include "posting_list.h"
+#include "thread_pool.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <set>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// How the terms of a query combine
+enum class SearchMode {
+    All,    // every term must match
+    Any     // at least one term matches
+};
+
+// The searchable text of a user
+struct UserText {
+    std::string_view username;
+    std::string_view name;
+    std::string_view bio;
+};
+
+struct SearchStats {
+    size_t postTerms = 0;
+    size_t userTerms = 0;
+    size_t postings = 0;        // entries across all lists
+    size_t listBytes = 0;       // compressed posting lists
+    size_t rawListBytes = 0;    // the same lists as plain 32-bit arrays
+};
+
+// Inverted index from words to the posts and users that contain them, plus
+// an ordered set of usernames for prefix lookups. Words are runs of
+// letters, digits, '_' and non-ASCII bytes, lower-cased, so "#Algorithms"
+// is found by "algorithms". Each word maps to a PostingList of handles.
+//
+// Not synchronized: callers serialize updates against queries.
+class SearchIndex {
+public:
+    static constexpr size_t MAX_TERM_LENGTH = 32;
+
+private:
+    using TermMap = std::unordered_map<std::string, PostingList>;
+
+    TermMap postTerms;
+    TermMap userTerms;
+    std::set<std::pair<std::string, UserIdx>> usernames;   // lower-cased
+
+    static void userTermsOf(const UserText& text, std::vector<std::string>& terms);
+    static void addTerms(TermMap& map, const std::vector<std::string>& terms, uint32_t id);
+    static void removeTerms(TermMap& map, const std::vector<std::string>& terms, uint32_t id);
+    static void find(const TermMap& map, const std::vector<std::string>& terms,
+                     SearchMode mode, std::vector<uint32_t>& out);
+
+public:
+    // Distinct words of text, in order of first appearance
+    static void tokenize(std::string_view text, std::vector<std::string>& terms);
+    static std::string lowerCase(std::string_view text);
+
+    void addPost(PostIdx post, std::string_view content);
+    void updatePost(PostIdx post, std::string_view oldContent, std::string_view newContent);
+    void addUser(UserIdx user, const UserText& text);
+    void updateUser(UserIdx user, const UserText& oldText, const UserText& newText);
+
+    // Matching handles in increasing order
+    void findPosts(const std::vector<std::string>& terms, SearchMode mode, std::vector<PostIdx>& out) const;
+    void findUsers(const std::vector<std::string>& terms, SearchMode mode, std::vector<UserIdx>& out) const;
+
+    // Users whose username starts with prefix (ignoring case), in name order
+    void usernamesWithPrefix(std::string_view prefix, size_t limit, std::vector<UserIdx>& out) const;
+
+    // Replace the index with the given posts and users. Documents are
+    // tokenized on the pool, and each worker then builds the lists for
+    // its own share of the terms.
+    void build(ThreadPool& pool,
+               const std::vector<std::pair<PostIdx, std::string_view>>& posts,
+               const std::vector<std::pair<UserIdx, UserText>>& users);
+
+    void clear();
+    SearchStats stats() const;
+};
+
+#endif // SEARCH_INDEX_H
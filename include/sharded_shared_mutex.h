@@ -0,0 +1,79 @@
+#ifndef SHARDED_SHARED_MUTEX_H
+#define SHARDED_SHARED_MUTEX_H
+
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+// Reader-writer lock split into shards, one cache line each. A reader only
+// touches the shard of its thread, so readers on different cores do not
+// fight over one lock word; a writer takes every shard, in order. Writers
+// go first: new readers wait while one is queued, so a steady stream of
+// readers cannot starve them. Meets the SharedMutex requirements, so
+// std::shared_lock and std::lock_guard work. Not recursive.
+class ShardedSharedMutex {
+public:
+    static const size_t SHARDS = 16;
+
+private:
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+    };
+    Shard shards[SHARDS];
+    std::mutex writerGate;                  // held by the writer in progress
+    std::atomic<int> waitingWriters{0};     // writers queued or in progress
+
+    // Threads are handed shards round-robin on first use
+    static size_t threadShard() {
+        static std::atomic<size_t> nextShard{0};
+        thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return shard;
+    }
+
+public:
+    ShardedSharedMutex() = default;
+    ShardedSharedMutex(const ShardedSharedMutex&) = delete;
+    ShardedSharedMutex& operator=(const ShardedSharedMutex&) = delete;
+
+    void lock() {
+        waitingWriters.fetch_add(1);
+        writerGate.lock();
+        for (Shard& s : shards) {
+            s.mutex.lock();
+        }
+    }
+
+    bool try_lock() {
+        if (!writerGate.try_lock()) return false;
+        for (size_t i = 0; i < SHARDS; ++i) {
+            if (!shards[i].mutex.try_lock()) {
+                while (i-- > 0) shards[i].mutex.unlock();
+                writerGate.unlock();
+                return false;
+            }
+        }
+        waitingWriters.fetch_add(1);
+        return true;
+    }
+
+    void unlock() {
+        for (size_t i = SHARDS; i-- > 0;) {
+            shards[i].mutex.unlock();
+        }
+        writerGate.unlock();
+        waitingWriters.fetch_sub(1);
+    }
+
+    void lock_shared() {
+        if (waitingWriters.load(std::memory_order_relaxed) > 0) {
+            // Let the queued writers through first
+            std::lock_guard<std::mutex> wait(writerGate);
+        }
+        shards[threadShard()].mutex.lock_shared();
+    }
+    bool try_lock_shared() { return shards[threadShard()].mutex.try_lock_shared(); }
+    void unlock_shared() { shards[threadShard()].mutex.unlock_shared(); }
+};
+
+#endif // SHARDED_SHARED_MUTEX_H
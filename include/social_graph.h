@@ -0,0 +1,141 @@
+#ifndef SOCIAL_GRAPH_H
+#define SOCIAL_GRAPH_H
+
+#include "id_interner.h"
+#include "adjacency_set.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Memory used by the follow graph
+struct GraphMemoryStats {
+    size_t vertices = 0;
+    size_t edges = 0;
+    size_t csrBytes = 0;        // offsets, degrees and encoded lists, both directions
+    size_t deltaEdits = 0;      // edits not yet merged into the CSR arrays
+    size_t deltaBytes = 0;      // approximate
+    size_t plainBytes = 0;      // same edges as two uint32 lists per user
+    double bytesPerEdge = 0.0;
+};
+
+// Follow graph in compressed sparse row form, stored in both directions
+// (following and followers). Each adjacency list is sorted and encoded
+// as its first index followed by the gaps between neighbours, all as
+// LEB128 varints. Every SKIP_INTERVAL-th neighbour also gets a skip entry,
+// so a membership test binary-searches the skips and decodes one short
+// run. Recent follow/unfollow edits sit in per-user delta sets until a
+// merge folds them into fresh arrays.
+//
+// The CSR arrays are immutable and shared, so copying a graph costs the
+// delta sets only; a copy is a consistent view for a background writer.
+class SocialGraph {
+private:
+    static constexpr uint32_t SKIP_INTERVAL = 64;
+
+    // Where decoding can resume inside a list: the neighbour before a
+    // skip point, and the byte offset (from the list start) after it
+    struct SkipEntry {
+        UserIdx last;
+        uint32_t byte;
+    };
+
+    struct Csr {
+        std::vector<uint64_t> offsets;   // byte offset of each list, plus end
+        std::vector<uint32_t> degrees;
+        std::vector<uint8_t> bytes;
+        std::vector<uint32_t> skipStart; // first skip entry of each list, plus end
+        std::vector<SkipEntry> skips;
+
+        size_t vertexCount() const { return degrees.size(); }
+        uint32_t degree(UserIdx u) const { return (u < degrees.size()) ? degrees[u] : 0; }
+        bool contains(UserIdx u, UserIdx v) const;
+        void decode(UserIdx u, std::vector<UserIdx>& out) const;
+        size_t memoryBytes() const;
+
+        // Building: reset, then append or copy each list in vertex order
+        void reset(size_t vertexCount, size_t reserveBytes);
+        void appendList(UserIdx u, const UserIdx* ids, size_t count);
+        void copyList(UserIdx u, const Csr& from);
+        void finish();
+    };
+
+    // One direction of the graph: merged arrays plus pending edits
+    struct Direction {
+        std::shared_ptr<const Csr> csr;
+        std::unordered_map<UserIdx, AdjacencySet> added;
+        std::unordered_map<UserIdx, AdjacencySet> removed;
+
+        bool contains(UserIdx u, UserIdx v) const;
+        size_t count(UserIdx u) const;
+        void list(UserIdx u, std::vector<UserIdx>& out) const;
+        void add(UserIdx u, UserIdx v);
+        void remove(UserIdx u, UserIdx v);
+        std::shared_ptr<const Csr> merged(std::vector<UserIdx>& touched) const;
+        void rebase(std::shared_ptr<const Csr> next, const std::vector<UserIdx>& touched);
+        size_t deltaEdits() const;
+        size_t deltaBytes() const;
+    };
+
+    Direction out;      // follower -> followees
+    Direction in;       // followee -> followers
+    size_t edges;
+    size_t pendingEdits;
+
+    static std::shared_ptr<const Csr> buildCsr(size_t vertexCount,
+                                               const std::vector<std::pair<UserIdx, UserIdx>>& pairs,
+                                               bool reverse);
+
+public:
+    // A merge is due once this many edits are pending (or an eighth of the
+    // edge count)
+    static constexpr size_t MIN_MERGE_EDITS = 4096;
+
+    // New arrays built by prepareMerge, for installMerge
+    struct PreparedMerge {
+        std::shared_ptr<const Csr> baseOut, baseIn;     // arrays the edits applied to
+        std::shared_ptr<const Csr> out, in;             // with the edits folded in
+        std::vector<UserIdx> touchedOut, touchedIn;     // lists the edits changed
+    };
+
+    SocialGraph();
+
+    // Replace the graph with (follower, followee) pairs; duplicates and
+    // self-follows are dropped
+    void bulkLoad(size_t vertexCount, std::vector<std::pair<UserIdx, UserIdx>> follows);
+
+    // Return true if the graph changed
+    bool follow(UserIdx follower, UserIdx followee);
+    bool unfollow(UserIdx follower, UserIdx followee);
+
+    bool isFollowing(UserIdx follower, UserIdx followee) const;
+    size_t followingCount(UserIdx u) const;
+    size_t followerCount(UserIdx u) const;
+
+    // Neighbours in ascending index order, written to out (which is cleared)
+    void following(UserIdx u, std::vector<UserIdx>& out) const;
+    void followers(UserIdx u, std::vector<UserIdx>& out) const;
+
+    size_t edgeCount() const { return edges; }
+    size_t pendingEditCount() const { return pendingEdits; }
+    bool mergeDue() const { return pendingEdits >= std::max(MIN_MERGE_EDITS, edges / 8); }
+
+    // Fold pending edits into new CSR arrays, in place
+    void mergeDeltas();
+
+    // The same merge in two steps, so the O(E) rebuild can run on a copy
+    // of the graph while the original keeps taking edits: prepareMerge
+    // on the copy, then installMerge on the original, which keeps only
+    // the edits made since the copy (costing the lists either set of edits
+    // touched). Returns false, changing nothing, if the original was merged
+    // or reloaded in between.
+    PreparedMerge prepareMerge() const;
+    bool installMerge(const PreparedMerge& merge);
+    void clear();
+    GraphMemoryStats memoryStats() const;
+};
+
+#endif // SOCIAL_GRAPH_H
@@ -0,0 +1,59 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+// Memory held by an arena
+struct ArenaStats {
+    size_t strings = 0;
+    size_t bytesUsed = 0;       // string bytes stored
+    size_t bytesReserved = 0;   // chunk memory allocated
+    size_t chunks = 0;
+};
+
+// Append-only storage for immutable text. Strings are packed end to end in
+// large chunks and handed out as string_views that stay valid for the life
+// of the process; nothing is ever freed or moved. Replacing a record's text
+// stores the new text and leaves the old bytes in place, which suits text
+// that is written once and edited rarely.
+//
+// Each thread bump-allocates from its own block, so parallel loaders only
+// take the arena lock once per block.
+class StringArena {
+public:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+private:
+    std::mutex chunkMutex;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::atomic<size_t> strings;
+    std::atomic<size_t> bytesUsed;
+    std::atomic<size_t> bytesReserved;
+    std::atomic<size_t> chunkCount;
+
+    char* allocate(size_t size);
+    void release(char* end, size_t unused);
+    char* newChunk(size_t size);
+
+public:
+    StringArena();
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view store(std::string_view text);
+
+    // Decode %xx escapes straight into the arena
+    std::string_view storeDecoded(std::string_view encoded);
+
+    ArenaStats stats() const;
+};
+
+// Process-wide arena for post content and profile text
+StringArena& textArena();
+
+#endif // STRING_ARENA_H
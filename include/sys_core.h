@@ -4,9 +4,67 @@
 #include "User.h"
 #include "Post.h"
 #include "Observer.h"
+#include "mutation_log.h"
+#include "thread_pool.h"
+#include "parallel_loader.h"
+#include "home_timeline.h"
+#include "social_graph.h"
+#include "like_index.h"
+#include "author_affinity.h"
+#include "feed_ranker.h"
+#include "trending.h"
+#include "search_index.h"
+#include "follow_recommender.h"
+#include "graph_analytics.h"
+#include "notification_dispatcher.h"
+#include "inbox_store.h"
+#include "post_table.h"
+#include "string_arena.h"
+#include "sharded_shared_mutex.h"
+#include <vector>
+#include <array>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+// Metrics from folding the mutation log into a new snapshot
+struct CompactionStats {
+    uint64_t runs = 0;
+    double lastDurationMs = 0.0;
+    uint64_t lastBytesWritten = 0;
+    uint64_t totalBytesWritten = 0;
+    uint64_t lastLogBytesFolded = 0;
+};
+
+// Record and text memory, compared with the same data held the old way
+// (one heap-allocated std::string per text field)
+struct TextMemoryStats {
+    size_t posts = 0;
+    size_t users = 0;
+    ArenaStats arena;
+    double bytesPerPost = 0.0;          // record plus content in the arena
+    double legacyBytesPerPost = 0.0;    // record plus content as std::string
+    double bytesPerUser = 0.0;
+    double legacyBytesPerUser = 0.0;
+};
+
+// One page of a feed, newest first. Pass nextCursor back as "before"
+// to fetch the following page; it is empty when nothing older is left.
+// Posts are handles to the stored records, not copies.
+struct FeedPage {
+    std::vector<PostRef> posts;
+    std::string nextCursor;
+};
+
+// A suggested account and how many of the reader's followees follow it
+struct FollowRecommendation {
+    std::shared_ptr<const User> user;
+    uint32_t mutuals;
+};
 
 class SystemCore {
 private:
@@ -14,13 +72,113 @@ private:
     static SystemCore* instance;
     static std::mutex instanceMutex;
 
-    // Data storage
-    std::unordered_map<std::string, User> users;
-    std::unordered_map<std::string, Post> posts;
-    std::unordered_map<std::string, std::unique_ptr<PostNotifier>> userNotifiers;
+    // Data storage, indexed by interned ID. Records are never changed once
+    // stored: writers replace them (see mutableUser/mutablePost), so readers
+    // and in-flight snapshots can keep the version they were handed.
+    // Slots for IDs that were interned but never added stay null.
+    std::vector<std::shared_ptr<User>> users;
+    std::vector<std::shared_ptr<Post>> posts;
+    std::vector<std::shared_ptr<PostNotifier>> userNotifiers;
+    size_t userCount;
+    size_t postCount;
+
+    // Hot post fields as columns (timestamp, author, likes, content), kept
+    // in step with posts by storePost. Feed merges, author index ordering
+    // and top-K scans read these instead of the records.
+    PostTable postTable;
+
+    // Username -> user slot, kept in step with users by storeUser. Keys view
+    // the usernames in textArena(), which are never moved or freed.
+    std::unordered_map<std::string_view, UserIdx> usernameIndex;
+
+    // Each author's posts, oldest first (by timestamp, then PostIdx)
+    std::vector<std::vector<PostIdx>> postsByAuthor;
+
+    // Follow edges (CSR arrays plus pending edits)
+    SocialGraph graph;
+
+    // Likes: counts are atomics in postTable's likes column, which the post
+    // records read through, and membership is in likeIndex, so a like needs
+    // only a shared coreMutex. Like records reach the mutation log in
+    // batches (see queueLike).
+    LikeIndex likeIndex;
+    AuthorAffinity affinity;        // likes per (user, author), for ranking
+    static const size_t LIKE_BATCH_SIZE = 256;
+    static constexpr std::chrono::milliseconds LIKE_BATCH_WINDOW{100};
+    std::mutex likeBatchMutex;
+    std::vector<std::pair<PostIdx, UserIdx>> pendingLikes;
+    std::chrono::steady_clock::time_point pendingLikesSince;
+
+    // Fan-out-on-write home timelines, indexed by UserIdx. Sized by storeUser;
+    // feed reads rebuild them under a shared coreMutex, so readers of one
+    // timeline also take its lock shard (writers already hold coreMutex
+    // exclusively).
+    std::vector<HomeTimeline> homeTimelines;
+    static const size_t TIMELINE_LOCKS = 64;
+    std::array<std::mutex, TIMELINE_LOCKS> timelineLocks;
+    FeedStrategy feedStrategy;
+    size_t celebrityThreshold;
+    size_t timelineCapacity;
+
+    // Notification inboxes, in memory only. addPost pushes under the
+    // exclusive coreMutex; reads and mark-read take it shared plus the
+    // user's lock shard. A post whose author has celebrityThreshold
+    // followers or more when it is made is not pushed: it goes on the
+    // author's pulled list instead, and readers merge in the lists of the
+    // people they follow; those above the user's read mark are unread.
+    // The choice is kept per post, so an author crossing the threshold
+    // either way neither repeats nor loses notifications.
+    InboxStore inboxes;
+    std::vector<FeedKey> inboxReadMarks;    // by UserIdx
+    std::vector<std::vector<PostIdx>> pulledInboxPosts;    // by author, oldest first
+    std::array<std::mutex, TIMELINE_LOCKS> inboxLocks;
     
-    // Mutex for thread safety
-    std::mutex coreMutex;
+    // Hashtag counts over the last hour and day, fed by addPostLocked and
+    // seeded from the newest day of posts at load time
+    TrendingHashtags trending;
+
+    // Word index over post content and user profiles
+    SearchIndex search;
+
+    // Follow suggestions per UserIdx from the last precomputeRecommendations,
+    // each list suggestionDepth long at most. followEdits counts each user's
+    // follows and unfollows; a list is used only while the count matches
+    // the one it was computed at. Changes in other users' follows are
+    // picked up at the next precompute.
+    std::vector<std::vector<FollowSuggestion>> suggestionCache;
+    std::vector<uint32_t> suggestionEdits;
+    std::vector<uint32_t> followEdits;
+    size_t suggestionDepth = 0;
+
+    // Guards all of the above: queries take it shared, mutators exclusive
+    mutable ShardedSharedMutex coreMutex;
+    using ReadLock = std::shared_lock<ShardedSharedMutex>;
+    using WriteLock = std::lock_guard<ShardedSharedMutex>;
+
+    // Append-only log of changes since the last snapshot
+    MutationLog mutationLog;
+
+    // Background snapshot compaction. The same thread folds pending follow
+    // edits into the graph's CSR arrays when a follow or unfollow finds a
+    // merge due, and logs a like batch once it is LIKE_BATCH_WINDOW old;
+    // without it both wait for the next compactNow.
+    std::thread compactionThread;
+    std::mutex compactionMutex;          // one compaction at a time
+    std::mutex compactionWaitMutex;
+    std::condition_variable compactionWake;
+    bool compactionStopping;
+    bool graphMergeWanted;
+    std::chrono::steady_clock::time_point likeFlushAt;   // max() when no batch is waiting
+    std::chrono::seconds compactionInterval;
+    uint64_t compactionMinLogBytes;
+    CompactionStats compactionStats;
+
+    // Workers for parallel loading
+    ThreadPool workerPool;
+    LoadTimings loadTimings;
+
+    // New-post notifications, delivered off the posting thread
+    NotificationDispatcher notifications;
 
     // Private constructor for Singleton
     SystemCore();
@@ -33,7 +191,76 @@ private:
     int nextUserID;
     int nextPostID;
 
-    // Helpers
+    // Helpers (callers hold coreMutex)
+    const User* findUser(UserIdx idx) const;
+    const Post* findPost(PostIdx idx) const;
+    User* mutableUser(UserIdx idx);
+    Post* mutablePost(PostIdx idx);
+    void storeUser(std::shared_ptr<User> u);
+    void storePost(std::shared_ptr<Post> p);
+    void indexPost(const Post& p);
+    void insertByKey(std::vector<PostIdx>& list, PostIdx post) const;
+    void rebuildAuthorIndex();
+
+    // Feed assembly
+    struct FeedSource {
+        const PostIdx* data;    // oldest first
+        size_t size;
+    };
+    enum class FolloweeSet { All, Celebrities, Regular };
+    bool mergeFeed(const std::vector<FeedSource>& sources, const FeedKey& bound,
+                   size_t limit, std::vector<PostIdx>& out) const;
+    std::vector<FeedSource> followeeSources(const User& user, FolloweeSet which) const;
+    bool isCelebrity(UserIdx idx) const;
+    bool mergeTimelineFeed(const User& user, const FeedKey& bound, size_t limit,
+                           std::vector<PostIdx>& out, bool& more);
+    bool feedHandles(const User& user, const FeedKey& bound, size_t limit, std::vector<PostIdx>& out);
+    bool collectCandidates(const std::string& userID, size_t limit, FeedCandidates& out);
+    void fanOutPost(const Post& p);
+    void deliverToInboxes(const Post& p);
+    bool isInboxPulled(UserIdx author) const;
+    std::vector<FeedSource> pulledInboxSources(UserIdx user) const;
+    std::shared_ptr<PostNotifier> notifierFor(UserIdx author) const;
+    void queueLike(PostIdx post, UserIdx user);
+    void writeLikeBatch(const std::vector<std::pair<PostIdx, UserIdx>>& batch);
+    void invalidateTimeline(UserIdx idx);
+    void invalidateFollowerTimelines(UserIdx idx);
+    HomeTimeline& freshTimeline(UserIdx idx);
+    void compactionLoop();
+    void requestGraphMerge();
+    void scheduleLikeFlush(std::chrono::steady_clock::time_point at);
+    void mergeGraphDeltas();
+    bool loadBinarySnapshot();
+    void importTextData();
+    void buildLoadIndexes();
+    void buildAffinity(std::vector<std::pair<PostIdx, UserIdx>>& likes);
+    void rebuildTrending();
+    void rebuildSearchIndex();
+    void countFollowEdit(UserIdx idx);
+    uint32_t followEditsOf(UserIdx idx) const;
+    std::vector<FollowRecommendation> resolveSuggestions(UserIdx user, const std::vector<FollowSuggestion>& list,
+                                                         size_t k) const;
+    void logLoadTimings();
+    TextMemoryStats textMemoryStatsLocked() const;
+    void captureView(std::vector<std::shared_ptr<const User>>& userView,
+                     std::vector<std::shared_ptr<const Post>>& postView,
+                     SocialGraph& graphView, LikeView& likeView);
+    static bool writeSnapshotFiles(const std::vector<std::shared_ptr<const User>>& userView,
+                                   const std::vector<std::shared_ptr<const Post>>& postView,
+                                   const SocialGraph& graphView,
+                                   const LikeView& likeView,
+                                   uint64_t& bytesWritten);
+    void replayMutationLog();
+    void applyMutation(const Mutation& m);
+    uint64_t logMutation(MutationType type, const std::string& payload);
+
+    // Unlocked mutators shared by the public API and log replay
+    bool addUserLocked(const User& u);
+    bool addPostLocked(const Post& p);
+    void editPostLocked(Post& post, const std::string& newContent);
+    void reindexUser(const User& user, const UserText& before);
+    bool followLocked(const std::string& followerID, const std::string& followeeID);
+    bool unfollowLocked(const std::string& followerID, const std::string& followeeID);
     
 public:
     // Singleton access
@@ -49,33 +276,126 @@ public:
     // Data persistence
     void loadAllData();
     void saveAllData();
+    bool exportTextData();
+    LoadTimings getLoadTimings() const;
+    void setFsyncPolicy(FsyncPolicy policy);
+
+    // Snapshot compaction
+    bool compactNow();
+    void startBackgroundCompaction(std::chrono::seconds interval, uint64_t minLogBytes = 64 * 1024);
+    void stopBackgroundCompaction();
+    CompactionStats getCompactionStats();
     
     void updateNextUserID();
     void updateNextPostID();
-    // User management
-    User* getUser(const std::string& userID);
+    // User management. Records are returned as shared immutable versions:
+    // safe to keep and read while other threads update the core.
+    std::shared_ptr<const User> getUser(const std::string& userID);
+    std::shared_ptr<const User> findUserByUsername(const std::string& username);
     bool addUser(const User& u);
     bool userExists(const std::string& userID);
     bool usernameExists(const std::string& username);
     std::vector<User> getAllUsers();
+    std::vector<std::shared_ptr<const User>> getUserList();   // no record copies
+    std::vector<std::string> getFollowingIDs(const std::string& userID);
+    std::vector<std::string> getFollowerIDs(const std::string& userID);
+    bool updateUserName(const std::string& userID, const std::string& name);
+    bool updateUserBio(const std::string& userID, const std::string& bio);
     
     // Post management
-    Post* getPost(const std::string& postID);
+    std::shared_ptr<const Post> getPost(const std::string& postID);
     bool addPost(const Post& p);
-    std::vector<Post> getPostsByUser(const std::string& userID);
+    std::vector<PostRef> getPostsByUser(const std::string& userID);
+    std::vector<PostIdx> getPostIndexByUser(const std::string& userID) const;
+    std::shared_ptr<const Post> getPostByIdx(PostIdx idx) const;
+    size_t getPostCountByUser(const std::string& userID) const;
     std::vector<Post> getAllPosts();
+    // Scans over the post columns; handles resolve through getPostByIdx
+    std::vector<PostIdx> getTopPosts(size_t k, PostOrder order) const;
+    void sortPostHandles(std::vector<PostIdx>& handles, PostOrder order) const;
+    uint64_t getTotalLikes() const;
+    // One like per user and post; false if either is unknown or the user
+    // already liked it. Returns before the like is durable: it is logged
+    // with its batch, when LIKE_BATCH_SIZE likes are pending or the first
+    // of them is LIKE_BATCH_WINDOW old (flushLikes, compaction and saves
+    // also log it).
+    bool likePost(const std::string& userID, const std::string& postID);
+    bool hasLiked(const std::string& userID, const std::string& postID);
+    void flushLikes();
+    bool editPost(const std::string& postID, const std::string& newContent);
     
     // Follow operations (bidirectional)
     bool followUser(const std::string& followerID, const std::string& followeeID);
     bool unfollowUser(const std::string& followerID, const std::string& followeeID);
+    bool isFollowing(const std::string& followerID, const std::string& followeeID);
+    int getFollowerCount(const std::string& userID);
+    int getFollowingCount(const std::string& userID);
+    GraphMemoryStats getGraphMemoryStats();
+    TextMemoryStats getTextMemoryStats();
     
-    // Observer pattern for notifications
+    // Observer pattern for notifications. Delivery is asynchronous; once
+    // removeObserverForUser returns the observer is no longer called.
     void registerObserverForUser(const std::string& userID, IObserver* observer);
+    void removeObserverForUser(const std::string& userID, IObserver* observer);
     void notifyFollowers(const std::string& userID, const Post& p);
+    void flushNotifications();
+    NotificationStats getNotificationStats() const;
+
+    // Inbox of posts by the people a user follows, newest first
+    size_t getUnreadCount(const std::string& userID);
+    std::vector<PostRef> getInbox(const std::string& userID, size_t limit, bool unreadOnly = false);
+    void markInboxRead(const std::string& userID);
+    InboxStats getInboxStats() const;
     
     // Feed generation
-    std::vector<Post> generateFeedForUser(const std::string& userID);
+    std::vector<PostRef> generateFeedForUser(const std::string& userID);
+    FeedPage getFeedPage(const std::string& userID, size_t limit, const std::string& before = "");
+    // Ranked feed: the newest candidateLimit posts from the user's followees,
+    // scored by Scorer (see feed_ranker.h) and cut to the best k
+    static const size_t DEFAULT_RANK_CANDIDATES = 1000;
+    template<typename Scorer>
+    std::vector<PostRef> getRankedFeed(const std::string& userID, size_t k,
+                                       const Scorer& scorer = Scorer(),
+                                       size_t candidateLimit = DEFAULT_RANK_CANDIDATES);
+    std::vector<PostRef> generateRankedFeedForUser(const std::string& userID, size_t k);
+    void setFeedStrategy(FeedStrategy strategy, size_t celebrityThreshold = 1000, size_t timelineCapacity = 500);
+    FeedStrategy getFeedStrategy() const;
     
+    // Trending hashtags, most used first. Windows end at the newest post.
+    std::vector<TrendingTag> getTrending(TrendWindow window, size_t k) const;
+    TrendingStats getTrendingStats() const;
+
+    // Search. Queries are split into words the same way as the indexed
+    // text; posts come back in the given order, users in UserIdx order.
+    std::vector<PostRef> searchPosts(const std::string& query, SearchMode mode,
+                                     PostOrder order, size_t limit);
+    std::vector<std::shared_ptr<const User>> searchUsers(const std::string& query, SearchMode mode, size_t limit);
+    std::vector<std::shared_ptr<const User>> findUsersByPrefix(const std::string& prefix, size_t limit);
+    SearchStats getSearchStats() const;
+
+    // Accounts to follow, ranked by mutual follows and, optionally, by the
+    // reader's likes (see FollowRecommender). Served from the precomputed
+    // lists when they are deep enough, otherwise computed on demand.
+    static constexpr size_t DEFAULT_SUGGESTIONS = 20;
+    std::vector<FollowRecommendation> recommendFollows(const std::string& userID, size_t k,
+                                                       bool weighByEngagement = true);
+    // Compute suggestions for every user on the worker pool (engagement-weighted).
+    // Runs as a stream of small blocks using at most half the workers, so
+    // other pool jobs keep running meanwhile.
+    void precomputeRecommendations(size_t k = DEFAULT_SUGGESTIONS);
+
+    // Follow graph analytics (see graph_analytics.h). Summaries and searches
+    // run on a copy of the graph taken under a shared lock, so follows and
+    // unfollows carry on meanwhile.
+    static constexpr int DEFAULT_SEPARATION_DEPTH = 6;
+    GraphSummary getGraphSummary();
+    std::vector<std::shared_ptr<const User>> getMutualFollowers(const std::string& userA, const std::string& userB);
+    // Hops from one user to the other along follows, or -1 if not within maxDepth
+    int getDegreesOfSeparation(const std::string& fromID, const std::string& toID,
+                               int maxDepth = DEFAULT_SEPARATION_DEPTH);
+    // How many users are first reached at each hop (index 0 is the user)
+    std::vector<size_t> getReachByDistance(const std::string& userID, int maxDepth);
+
     // Statistics
     int getUserCount() const;
     int getPostCount() const;
@@ -84,4 +404,23 @@ public:
     void clearAllData();
 };
 
+template<typename Scorer>
+std::vector<PostRef> SystemCore::getRankedFeed(const std::string& userID, size_t k,
+                                               const Scorer& scorer, size_t candidateLimit) {
+    std::vector<PostRef> result;
+    FeedCandidates candidates;
+    std::vector<float> scores;
+    std::vector<uint32_t> order;
+
+    ReadLock lock(coreMutex);
+    if (k == 0 || !collectCandidates(userID, candidateLimit, candidates)) return result;
+
+    rankCandidates(candidates, scorer, k, scores, order);
+    result.reserve(order.size());
+    for (uint32_t i : order) {
+        result.push_back(posts[candidates.posts[i]]);
+    }
+    return result;
+}
+
 #endif // SYSTEMCORE_H
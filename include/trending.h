@@ -0,0 +1,91 @@
+#ifndef TRENDING_H
+#define TRENDING_H
+
+#include "count_min_sketch.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Sliding windows that trending counts are kept for
+enum class TrendWindow {
+    LastHour,
+    LastDay
+};
+
+struct TrendingTag {
+    std::string tag;        // lower case, without the '#'
+    uint32_t count;         // estimated uses within the window
+};
+
+struct TrendingStats {
+    uint64_t posts = 0;         // posts counted
+    uint64_t hashtags = 0;      // hashtag uses counted
+    uint64_t stale = 0;         // uses older than the longest window, skipped
+    size_t bytes = 0;           // sketches plus candidate lists
+};
+
+// Hashtag counts over sliding time windows, in bounded space. Time is cut
+// into BUCKET_SECONDS buckets, each with its own Count-Min sketch, held in
+// a ring that spans the longest window. Each window keeps a running sketch
+// of its buckets: a new use is added to it, and a bucket that slides out is
+// subtracted. Alongside, each window keeps the CANDIDATES tags with the
+// highest estimates, so a top-K query sorts a few dozen entries and never
+// looks at posts.
+//
+// Windows end at the newest timestamp seen, not the wall clock, so loading
+// or replaying old data reproduces the trends as they were.
+//
+// Not synchronized: callers serialize add/advanceTo against everything else.
+class TrendingHashtags {
+public:
+    static const uint64_t BUCKET_SECONDS = 300;
+    static const size_t BUCKETS = 24 * 3600 / BUCKET_SECONDS;
+    static const size_t CANDIDATES = 64;
+    static constexpr size_t MAX_TAG_LENGTH = 64;
+
+private:
+    struct Candidate {
+        uint64_t hash;
+        std::string tag;
+        uint32_t count;
+    };
+    struct Window {
+        uint64_t buckets;                   // width in buckets
+        CountMinSketch sketch;
+        std::vector<Candidate> candidates;
+    };
+
+    std::vector<CountMinSketch> ring;       // bucket b lives at b % BUCKETS
+    Window windows[2];                      // indexed by TrendWindow
+    uint64_t head;                          // newest bucket number
+    bool started;
+    TrendingStats counters;
+    std::vector<std::string> scratch;
+
+    void expire(Window& w, uint64_t bucket);
+    void refreshCandidates(Window& w);
+    void offer(Window& w, uint64_t hash, const std::string& tag);
+
+public:
+    TrendingHashtags();
+
+    // Hashtags in text: '#' then letters, digits or '_', lower-cased.
+    // Tags longer than MAX_TAG_LENGTH are cut.
+    static void extractHashtags(std::string_view text, std::vector<std::string>& out);
+
+    // Count the hashtags of a post made at timestamp (seconds)
+    void add(std::string_view text, uint64_t timestamp);
+
+    // Slide the windows forward to end at timestamp
+    void advanceTo(uint64_t timestamp);
+
+    // Up to k tags, most used first
+    void top(TrendWindow window, size_t k, std::vector<TrendingTag>& out) const;
+
+    void clear();
+    TrendingStats stats() const;
+};
+
+#endif // TRENDING_H
@@ -2,17 +2,20 @@
 #define USER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
+#include "id_interner.h"
+#include "adjacency_set.h"
 
 class User {
 private:
-    std::string userID;
-    std::string username;
-    std::string name;
-    std::string bio;
-    std::vector<std::string> followers;
-    std::vector<std::string> following;
+    friend class BinarySnapshot;
+
+    UserIdx idx;                    // interned userID
+    std::string_view username;      // text lives in textArena()
+    std::string_view name;
+    std::string_view bio;
 
 public:
     // Constructors
@@ -20,34 +23,34 @@ public:
     User(const std::string& id, const std::string& uname);
     User(const std::string& id, const std::string& uname, const std::string& n, const std::string& b);
 
-    // Getters
-    std::string getUserID() const;
-    std::string getUsername() const;
-    std::string getName() const;
-    std::string getBio() const;
-    std::vector<std::string> getFollowers() const;
-    std::vector<std::string> getFollowing() const;
-    int getFollowerCount() const;
-    int getFollowingCount() const;
+    // Getters. Text views point into textArena() and stay valid after the
+    // record is replaced.
+    const std::string& getUserID() const;
+    UserIdx getIdx() const;
+    std::string_view getUsername() const;
+    std::string_view getName() const;
+    std::string_view getBio() const;
+
+    // Sizes of username, name and bio, for memory accounting
+    void textSizes(size_t sizes[3]) const {
+        sizes[0] = username.size();
+        sizes[1] = name.size();
+        sizes[2] = bio.size();
+    }
 
     // Setters
     void setName(const std::string& n);
     void setBio(const std::string& b);
 
-    // Follow/Follower Management
-    void addFollower(const std::string& followerID);
-    void removeFollower(const std::string& followerID);
-    void follow(const std::string& otherUserID);
-    void unfollow(const std::string& otherUserID);
-    bool isFollowing(const std::string& otherUserID) const;
-    bool hasFollower(const std::string& followerID) const;
-
-    // Serialization for persistence
-    std::string serialize() const;
-    static User deserialize(const std::string& line);
+    // Serialization for persistence. Follow edges live in SocialGraph;
+    // they are passed in and out here because the text format carries them.
+    std::string serialize(IdView followers = IdView(), IdView following = IdView()) const;
+    static User deserialize(std::string_view line,
+                            std::vector<UserIdx>* followers = nullptr,
+                            std::vector<UserIdx>* following = nullptr);
 
     // Display
-    void displayProfile() const;
+    void displayProfile(size_t followerCount, size_t followingCount) const;
 };
 
 #endif // USER_H
\ No newline at end of file
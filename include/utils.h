@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 #include <sstream>
@@ -18,11 +19,18 @@ std::string formatTimestamp(uint64_t timestamp);
 
 // String utilities
 std::vector<std::string> safeSplit(const std::string& s, char delim);
-std::string urlEncode(const std::string& value);
+std::string urlEncode(std::string_view value);
 std::string urlDecode(const std::string& value);
 std::string trim(const std::string& str);
 
-// Logging
+// Durability: flush a file's data, or a directory's entries (so a rename
+// or create inside it survives a power loss), to stable storage
+bool fsyncFile(const std::string& path);
+bool fsyncDirectory(const std::string& dir);
+
+// Logging: log() appends to data/logs.txt and echoes to the console from a
+// background thread; flushLog() waits until everything queued is written
 void log(const std::string& level, const std::string& message);
+void flushLog();
 
 #endif // UTILS_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "adjacency_set.h"
+#include "field_parser.h"
+#include <algorithm>
+
+// ---------------------- ID Lists ----------------------
+void appendUserIDList(std::string& out, IdView ids) {
+    const IdInterner& table = userIdTable();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        out += table.name(ids[i]);
+        if (i < ids.size() - 1) out += ",";
+    }
+}
+
+// dst is sized up front
+void splitUserIDList(std::string_view list, std::vector<UserIdx>& dst) {
+    IdInterner& table = userIdTable();
+    dst.reserve(countByte(list, ',') + 1);
+    FieldTokenizer tokens(list, ',');
+    std::string_view id;
+    while (tokens.next(id)) {
+        if (!id.empty()) dst.push_back(table.intern(id));
+    }
+}
+
+// ---------------------- Representation Switch ----------------------
+void AdjacencySet::promote() {
+    position.reserve(items.size() * 2);
+    for (size_t i = 0; i < items.size(); ++i) {
+        position.emplace(items[i], static_cast<uint32_t>(i));
+    }
+    large = true;
+}
+
+void AdjacencySet::demote() {
+    std::unordered_map<UserIdx, uint32_t>().swap(position);
+    std::sort(items.begin(), items.end());
+    large = false;
+}
+
+// ---------------------- Updates ----------------------
+bool AdjacencySet::insert(UserIdx idx) {
+    if (large) {
+        if (!position.emplace(idx, static_cast<uint32_t>(items.size())).second) return false;
+        items.push_back(idx);
+        return true;
+    }
+
+    auto it = std::lower_bound(items.begin(), items.end(), idx);
+    if (it != items.end() && *it == idx) return false;
+    items.insert(it, idx);
+
+    if (items.size() > LARGE_THRESHOLD) promote();
+    return true;
+}
+
+bool AdjacencySet::erase(UserIdx idx) {
+    if (large) {
+        auto found = position.find(idx);
+        if (found == position.end()) return false;
+
+        // Move the last member into the hole
+        uint32_t hole = found->second;
+        position.erase(found);
+        if (hole != items.size() - 1) {
+            items[hole] = items.back();
+            position[items[hole]] = hole;
+        }
+        items.pop_back();
+
+        if (items.size() < SMALL_THRESHOLD) demote();
+        return true;
+    }
+
+    auto it = std::lower_bound(items.begin(), items.end(), idx);
+    if (it == items.end() || *it != idx) return false;
+    items.erase(it);
+    return true;
+}
+
+bool AdjacencySet::contains(UserIdx idx) const {
+    if (large) return position.find(idx) != position.end();
+    return std::binary_search(items.begin(), items.end(), idx);
+}
+
+void AdjacencySet::assign(std::vector<UserIdx> ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    items = std::move(ids);
+    std::unordered_map<UserIdx, uint32_t>().swap(position);
+    large = false;
+    if (items.size() > LARGE_THRESHOLD) promote();
+}
@@ -0,0 +1,294 @@
+#include "async_logger.h"
+#include "utils.h"
+#include <iostream>
+#include <cstdlib>
+
+static const char* const LOG_PATH = "data/logs.txt";
+
+// ---------------------- Static Member Initialization ----------------------
+AsyncLogger* AsyncLogger::instance = nullptr;
+std::mutex AsyncLogger::instanceMutex;
+
+// ---------------------- Constructor / Destructor ----------------------
+AsyncLogger::AsyncLogger()
+    : slots(new Slot[CAPACITY]), tail(0), head(0), activeProducers(0),
+      minLevel(LogLevel::Info), overflowPolicy(OverflowPolicy::Drop),
+      written(0), dropped(0), droppedReported(0),
+      running(true), writerSleeping(false), writerExited(false), flushWaiters(0),
+      file(nullptr), cachedSecond(0) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    shutdown();
+}
+
+// ---------------------- Singleton Access ----------------------
+// Never deleted: static destructors that run after the atexit hook may still log
+AsyncLogger& AsyncLogger::getInstance() {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!instance) {
+        instance = new AsyncLogger();
+        std::atexit(&AsyncLogger::shutdownAtExit);
+    }
+    return *instance;
+}
+
+void AsyncLogger::shutdownAtExit() {
+    if (instance) instance->shutdown();
+}
+
+// ---------------------- Levels ----------------------
+LogLevel AsyncLogger::parseLevel(const std::string& name) {
+    if (name == "INFO") return LogLevel::Info;
+    if (name == "WARNING") return LogLevel::Warning;
+    if (name == "ERROR") return LogLevel::Error;
+    if (name == "DEBUG") return LogLevel::Debug;
+    return LogLevel::Info;
+}
+
+const char* AsyncLogger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error:   return "ERROR";
+    }
+    return "INFO";
+}
+
+void AsyncLogger::setMinLevel(LogLevel level) {
+    minLevel.store(level, std::memory_order_relaxed);
+}
+
+LogLevel AsyncLogger::getMinLevel() const {
+    return minLevel.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::setOverflowPolicy(OverflowPolicy policy) {
+    overflowPolicy.store(policy, std::memory_order_relaxed);
+}
+
+LoggerStats AsyncLogger::getStats() const {
+    LoggerStats stats;
+    stats.written = written.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------- Producers ----------------------
+// Bounded ring with a sequence number per slot: a slot is free for the
+// producer at position pos when its sequence equals pos, and readable by
+// the writer once the producer has published pos + 1.
+bool AsyncLogger::tryPush(LogLevel level, uint64_t timestamp, const std::string& message) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots[pos & (CAPACITY - 1)];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.level = level;
+                slot.timestamp = timestamp;
+                slot.message.assign(message);   // reuses the slot's buffer
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;   // full: the writer has not freed this slot yet
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Only costs a lock when the writer is actually asleep. Producer and
+// writer both exchange writerSleeping, so their read-modify-writes are
+// ordered: either this one sees the writer's true and wakes it, or the
+// writer's exchange comes after and it sees the message just published.
+void AsyncLogger::wakeWriter() {
+    if (writerSleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+void AsyncLogger::write(LogLevel level, const std::string& message) {
+    if (level < minLevel.load(std::memory_order_relaxed)) return;
+    uint64_t timestamp = currentTimestamp();
+
+    activeProducers.fetch_add(1);
+    if (!running.load()) {
+        activeProducers.fetch_sub(1);
+        writeDirect(level, timestamp, message);
+        return;
+    }
+
+    bool mayDrop = overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::Drop &&
+                   level < LogLevel::Warning;
+    while (!tryPush(level, timestamp, message)) {
+        if (mayDrop) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        // Backpressure: let the writer catch up
+        wakeWriter();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    activeProducers.fetch_sub(1);
+    wakeWriter();
+}
+
+// ---------------------- Writer Thread ----------------------
+void AsyncLogger::writerLoop() {
+    while (true) {
+        size_t count = drain();
+        if (count > 0 && flushWaiters.load() == 0) continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (flushWaiters.load() > 0) drained.notify_all();
+        if (count > 0) continue;
+        if (!running.load() && activeProducers.load() == 0) {
+            lock.unlock();
+            // Producers that got in before shutdown have all published
+            drain();
+            break;
+        }
+
+        writerSleeping.exchange(true);
+        Slot& next = slots[head & (CAPACITY - 1)];
+        if (next.sequence.load(std::memory_order_acquire) != head + 1 && running.load()) {
+            // The timeout bounds the delay should a wakeup slip past the flag
+            wake.wait_for(lock, std::chrono::milliseconds(50));
+        }
+        writerSleeping.store(false);
+    }
+
+    writeBuffers();
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    writerExited.store(true);
+    drained.notify_all();
+}
+
+// Write out every published message; returns how many there were
+size_t AsyncLogger::drain() {
+    size_t count = 0;
+    while (true) {
+        Slot& slot = slots[head & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+
+        formatLine(slot.level, slot.timestamp, slot.message);
+        slot.sequence.store(head + CAPACITY, std::memory_order_release);
+        ++head;
+        ++count;
+    }
+
+    uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported) {
+        formatLine(LogLevel::Warning, currentTimestamp(),
+                   std::to_string(droppedNow - droppedReported) + " log message(s) dropped, log buffer full");
+        droppedReported = droppedNow;
+    }
+
+    if (!fileBuffer.empty()) {
+        writeBuffers();
+        written.fetch_add(count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+// Same line formats as the old synchronous log()
+static void appendLine(std::string& fileOut, std::string& consoleOut, const std::string& time,
+                       const char* level, const std::string& message) {
+    fileOut += '[';
+    fileOut += time;
+    fileOut += "] ";
+    fileOut += level;
+    fileOut += ": ";
+    fileOut += message;
+    fileOut += '\n';
+
+    consoleOut += '[';
+    consoleOut += level;
+    consoleOut += "] ";
+    consoleOut += message;
+    consoleOut += '\n';
+}
+
+// Messages mostly arrive within the same second, so the text is reused
+void AsyncLogger::formatLine(LogLevel level, uint64_t timestamp, const std::string& message) {
+    if (timestamp != cachedSecond || cachedTime.empty()) {
+        cachedTime = formatTimestamp(timestamp);
+        cachedSecond = timestamp;
+    }
+    appendLine(fileBuffer, consoleBuffer, cachedTime, levelName(level), message);
+}
+
+void AsyncLogger::writeBuffers() {
+    if (!fileBuffer.empty() && ensureFile()) {
+        std::fwrite(fileBuffer.data(), 1, fileBuffer.size(), file);
+        std::fflush(file);
+    }
+    fileBuffer.clear();
+
+    if (!consoleBuffer.empty()) {
+        std::cout.write(consoleBuffer.data(), static_cast<std::streamsize>(consoleBuffer.size()));
+        std::cout.flush();
+        consoleBuffer.clear();
+    }
+}
+
+// data/ may not exist yet when the first message arrives; retry once a second
+bool AsyncLogger::ensureFile() {
+    if (file) return true;
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastOpenAttempt < std::chrono::seconds(1)) return false;
+    lastOpenAttempt = now;
+    file = std::fopen(LOG_PATH, "a");
+    return file != nullptr;
+}
+
+// ---------------------- Flush / Shutdown ----------------------
+// Every claimed slot below target is counted in written once it is on disk
+void AsyncLogger::flush() {
+    uint64_t target = tail.load();
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    flushWaiters.fetch_add(1);
+    wake.notify_one();
+    drained.wait_for(lock, std::chrono::seconds(5), [this, target] {
+        return writerExited.load() || written.load() >= target;
+    });
+    flushWaiters.fetch_sub(1);
+}
+
+void AsyncLogger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        if (!running.load()) return;
+        running.store(false);
+        wake.notify_one();
+    }
+    if (writer.joinable()) writer.join();
+
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+// The old open-write-close path; the writer may still be draining, so
+// nothing here touches its buffers or file handle
+void AsyncLogger::writeDirect(LogLevel level, uint64_t timestamp, const std::string& message) {
+    std::string fileLine, consoleLine;
+    appendLine(fileLine, consoleLine, formatTimestamp(timestamp), levelName(level), message);
+
+    std::lock_guard<std::mutex> lock(directMutex);
+    if (FILE* f = std::fopen(LOG_PATH, "a")) {
+        std::fwrite(fileLine.data(), 1, fileLine.size(), f);
+        std::fclose(f);
+    }
+    std::cout << consoleLine << std::flush;
+}
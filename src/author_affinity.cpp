@@ -0,0 +1,52 @@
+#include "author_affinity.h"
+#include <algorithm>
+
+void AuthorAffinity::add(UserIdx user, UserIdx author) {
+    Shard& shard = shardFor(user);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::vector<Entry>& tally = shard.byUser[user];
+    auto it = std::lower_bound(tally.begin(), tally.end(), author,
+                               [](const Entry& e, UserIdx a) { return e.author < a; });
+    if (it != tally.end() && it->author == author) {
+        it->likes++;
+    } else {
+        tally.insert(it, Entry{author, 1});
+    }
+}
+
+void AuthorAffinity::bulkLoad(std::vector<std::pair<UserIdx, UserIdx>> likes) {
+    clear();
+    std::sort(likes.begin(), likes.end());
+
+    std::vector<Entry> tally;
+    size_t i = 0;
+    while (i < likes.size()) {
+        UserIdx user = likes[i].first;
+        tally.clear();
+        for (; i < likes.size() && likes[i].first == user; ++i) {
+            if (!tally.empty() && tally.back().author == likes[i].second) {
+                tally.back().likes++;
+            } else {
+                tally.push_back(Entry{likes[i].second, 1});
+            }
+        }
+        Shard& shard = shardFor(user);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.byUser[user] = tally;
+    }
+}
+
+void AuthorAffinity::copyFor(UserIdx user, std::vector<Entry>& out) const {
+    out.clear();
+    const Shard& shard = shardFor(user);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.byUser.find(user);
+    if (it != shard.byUser.end()) out = it->second;
+}
+
+void AuthorAffinity::clear() {
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.byUser.clear();
+    }
+}
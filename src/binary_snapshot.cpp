@@ -0,0 +1,316 @@
+#include "binary_snapshot.h"
+#include "string_arena.h"
+#include "utils.h"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---------------------- Read-only File Mapping ----------------------
+// mmap on POSIX; Windows builds fall back to reading the file into memory
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#else
+    void* mapping;
+#endif
+
+public:
+    MappedFile() : bytes(nullptr), length(0)
+#ifndef _WIN32
+        , mapping(nullptr)
+#endif
+    {}
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapping) munmap(mapping, length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) return false;
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                ::close(fd);
+                return false;
+            }
+            // The whole file is read front to back exactly once
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+        return true;
+#endif
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// ---------------------- Writing ----------------------
+static SnapshotStrRef appendString(std::string& blob, std::string_view s) {
+    if (blob.size() + s.size() > UINT32_MAX) {
+        throw std::runtime_error("Snapshot string blob exceeds 4 GiB");
+    }
+    SnapshotStrRef ref{static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(s.size())};
+    blob += s;
+    return ref;
+}
+
+bool BinarySnapshot::write(const std::string& path,
+                           const std::vector<std::shared_ptr<const User>>& userView,
+                           const std::vector<std::shared_ptr<const Post>>& postView,
+                           const SocialGraph& graph,
+                           const LikeView& likes,
+                           uint64_t& bytesWritten) {
+    bytesWritten = 0;
+
+    // Table position of every user, by interned index
+    std::vector<uint32_t> tablePos(userIdTable().size(), INVALID_IDX);
+    for (size_t i = 0; i < userView.size(); ++i) {
+        if (userView[i]->idx < tablePos.size()) {
+            tablePos[userView[i]->idx] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<SnapshotUserRecord> userTable;
+    std::vector<SnapshotPostRecord> postTable;
+    std::vector<uint32_t> edges;
+    std::string blob;
+    userTable.reserve(userView.size());
+    postTable.reserve(postView.size());
+
+    try {
+        // Edges to users missing from the table cannot be indexed and are dropped
+        std::vector<UserIdx> ids;
+        auto appendEdges = [&](uint32_t& begin, uint32_t& count, IdView list) {
+            begin = static_cast<uint32_t>(edges.size());
+            for (UserIdx id : list) {
+                if (id < tablePos.size() && tablePos[id] != INVALID_IDX) edges.push_back(tablePos[id]);
+            }
+            count = static_cast<uint32_t>(edges.size()) - begin;
+        };
+        auto scratch = [&ids]() { return IdView(ids.data(), ids.size()); };
+
+        for (const auto& u : userView) {
+            SnapshotUserRecord rec{};
+            rec.userID = appendString(blob, userIdTable().name(u->idx));
+            rec.username = appendString(blob, u->username);
+            rec.name = appendString(blob, u->name);
+            rec.bio = appendString(blob, u->bio);
+            graph.followers(u->idx, ids);
+            appendEdges(rec.followersBegin, rec.followersCount, scratch());
+            graph.following(u->idx, ids);
+            appendEdges(rec.followingBegin, rec.followingCount, scratch());
+            userTable.push_back(rec);
+        }
+
+        for (const auto& p : postView) {
+            SnapshotPostRecord rec{};
+            rec.postID = appendString(blob, postIdTable().name(p->idx));
+            rec.userID = appendString(blob, userIdTable().name(p->authorIdx));
+            rec.content = appendString(blob, p->content);
+            rec.timestamp = p->timestamp;
+            rec.likes = likes.count(p->idx);
+            appendEdges(rec.likersBegin, rec.likersCount, likes.likersOf(p->idx));
+            postTable.push_back(rec);
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.userCount = userTable.size();
+    header.postCount = postTable.size();
+    header.userTableOffset = sizeof(SnapshotHeader);
+    header.postTableOffset = header.userTableOffset + userTable.size() * sizeof(SnapshotUserRecord);
+    header.edgeOffset = header.postTableOffset + postTable.size() * sizeof(SnapshotPostRecord);
+    header.edgeCount = edges.size();
+    header.blobOffset = header.edgeOffset + edges.size() * sizeof(uint32_t);
+    header.blobSize = blob.size();
+
+    std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(userTable.data()), userTable.size() * sizeof(SnapshotUserRecord));
+    out.write(reinterpret_cast<const char*>(postTable.data()), postTable.size() * sizeof(SnapshotPostRecord));
+    out.write(reinterpret_cast<const char*>(edges.data()), edges.size() * sizeof(uint32_t));
+    out.write(blob.data(), blob.size());
+    out.close();
+    if (!out) return false;
+
+    // The data must be on disk before the rename can point at it, and the
+    // rename itself must be on disk before the caller drops older state
+    if (!fsyncFile(tmpPath)) return false;
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) return false;
+    size_t slash = path.find_last_of('/');
+    if (!fsyncDirectory(slash == std::string::npos ? "." : path.substr(0, slash))) return false;
+
+    bytesWritten = header.blobOffset + header.blobSize;
+    return true;
+}
+
+// ---------------------- Loading ----------------------
+bool BinarySnapshot::load(const std::string& path, std::vector<User>& usersOut, std::vector<Post>& postsOut,
+                          std::vector<std::pair<UserIdx, UserIdx>>& followsOut,
+                          std::vector<std::pair<PostIdx, UserIdx>>& likesOut) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+
+    const char* base = file.data();
+    const size_t size = file.size();
+
+    if (size < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Snapshot too small");
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a snapshot file");
+    }
+    if ((header.version != 1 && header.version != SNAPSHOT_VERSION) ||
+        header.headerSize != sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
+    }
+    const size_t postWidth = (header.version == 1) ? sizeof(SnapshotPostRecordV1) : sizeof(SnapshotPostRecord);
+
+    auto sectionFits = [size](uint64_t offset, uint64_t count, uint64_t width) {
+        return offset <= size && count <= (size - offset) / width;
+    };
+    if (!sectionFits(header.userTableOffset, header.userCount, sizeof(SnapshotUserRecord)) ||
+        !sectionFits(header.postTableOffset, header.postCount, postWidth) ||
+        !sectionFits(header.edgeOffset, header.edgeCount, sizeof(uint32_t)) ||
+        !sectionFits(header.blobOffset, header.blobSize, 1)) {
+        throw std::runtime_error("Snapshot sections out of bounds");
+    }
+
+    const char* blob = base + header.blobOffset;
+    auto view = [&](const SnapshotStrRef& ref) {
+        if (static_cast<uint64_t>(ref.offset) + ref.length > header.blobSize) {
+            throw std::runtime_error("Snapshot string out of bounds");
+        }
+        return std::string_view(blob + ref.offset, ref.length);
+    };
+    // Text is copied out of the mapping into the arena
+    auto assign = [&](std::string_view& dst, const SnapshotStrRef& ref) {
+        dst = textArena().store(view(ref));
+    };
+
+    // Record tables are read in place; memcpy keeps unaligned access well-defined
+    std::vector<SnapshotUserRecord> userTable(header.userCount);
+    std::memcpy(userTable.data(), base + header.userTableOffset, header.userCount * sizeof(SnapshotUserRecord));
+    std::vector<uint32_t> edges(header.edgeCount);
+    std::memcpy(edges.data(), base + header.edgeOffset, header.edgeCount * sizeof(uint32_t));
+
+    usersOut.clear();
+    usersOut.resize(header.userCount);
+    for (size_t i = 0; i < userTable.size(); ++i) {
+        const SnapshotUserRecord& rec = userTable[i];
+        User& u = usersOut[i];
+        u.idx = userIdTable().intern(view(rec.userID));
+        assign(u.username, rec.username);
+        assign(u.name, rec.name);
+        assign(u.bio, rec.bio);
+    }
+
+    // Edges are table positions, so map them once every user has an index.
+    // Both lists are kept; the graph drops the duplicate pairs.
+    auto resolveEdges = [&](UserIdx self, bool selfFollows, uint32_t begin, uint32_t count) {
+        if (static_cast<uint64_t>(begin) + count > edges.size()) {
+            throw std::runtime_error("Snapshot edge list out of bounds");
+        }
+        for (uint32_t e = begin; e < begin + count; ++e) {
+            if (edges[e] >= usersOut.size()) {
+                throw std::runtime_error("Snapshot edge references unknown user");
+            }
+            UserIdx other = usersOut[edges[e]].idx;
+            followsOut.push_back(selfFollows ? std::make_pair(self, other) : std::make_pair(other, self));
+        }
+    };
+    followsOut.clear();
+    followsOut.reserve(edges.size());
+    for (size_t i = 0; i < userTable.size(); ++i) {
+        resolveEdges(usersOut[i].idx, false, userTable[i].followersBegin, userTable[i].followersCount);
+        resolveEdges(usersOut[i].idx, true, userTable[i].followingBegin, userTable[i].followingCount);
+    }
+
+    postsOut.clear();
+    postsOut.resize(header.postCount);
+    likesOut.clear();
+    const char* postBase = base + header.postTableOffset;
+    for (size_t i = 0; i < postsOut.size(); ++i) {
+        SnapshotPostRecord rec{};
+        if (header.version == 1) {
+            SnapshotPostRecordV1 old;
+            std::memcpy(&old, postBase + i * postWidth, sizeof(old));
+            rec.postID = old.postID;
+            rec.userID = old.userID;
+            rec.content = old.content;
+            rec.timestamp = old.timestamp;
+            rec.likes = old.likes;
+        } else {
+            std::memcpy(&rec, postBase + i * postWidth, sizeof(rec));
+        }
+        Post& p = postsOut[i];
+        p.idx = postIdTable().intern(view(rec.postID));
+        p.authorIdx = userIdTable().intern(view(rec.userID));
+        assign(p.content, rec.content);
+        p.timestamp = rec.timestamp;
+        p.setLikes(rec.likes);
+
+        if (static_cast<uint64_t>(rec.likersBegin) + rec.likersCount > edges.size()) {
+            throw std::runtime_error("Snapshot liker list out of bounds");
+        }
+        for (uint32_t e = rec.likersBegin; e < rec.likersBegin + rec.likersCount; ++e) {
+            if (edges[e] >= usersOut.size()) {
+                throw std::runtime_error("Snapshot liker references unknown user");
+            }
+            likesOut.emplace_back(p.idx, usersOut[edges[e]].idx);
+        }
+    }
+
+    return true;
+}
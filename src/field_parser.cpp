@@ -0,0 +1,148 @@
+#include "field_parser.h"
+#include <charconv>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FIELD_PARSER_AVX2 1
+#define FIELD_PARSER_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FIELD_PARSER_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// ---------------------- Bit Helpers ----------------------
+static inline unsigned lowestSetBit(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+static inline unsigned popCount(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return static_cast<unsigned>(__popcnt(mask));
+#else
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+}
+
+// ---------------------- Byte Scanning ----------------------
+const char* findByte(const char* p, const char* end, char c) {
+#ifdef FIELD_PARSER_AVX2
+    const __m256i needle32 = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle32)));
+        if (mask) return p + lowestSetBit(mask);
+        p += 32;
+    }
+#endif
+#ifdef FIELD_PARSER_SSE2
+    const __m128i needle16 = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle16)));
+        if (mask) return p + lowestSetBit(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != c) ++p;
+    return p;
+}
+
+size_t countByte(std::string_view s, char c) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    size_t count = 0;
+#ifdef FIELD_PARSER_AVX2
+    const __m256i needle32 = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        count += popCount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle32))));
+        p += 32;
+    }
+#endif
+#ifdef FIELD_PARSER_SSE2
+    const __m128i needle16 = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        count += popCount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle16))));
+        p += 16;
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == c) count++;
+    }
+    return count;
+}
+
+// ---------------------- Field Splitting ----------------------
+size_t splitFields(std::string_view s, char delim, std::string_view* out, size_t maxFields) {
+    FieldTokenizer tokens(s, delim);
+    size_t count = 0;
+    while (count < maxFields && tokens.next(out[count])) {
+        count++;
+    }
+    return count;
+}
+
+// ---------------------- Percent Decoding ----------------------
+// Hex digit value, or -1
+static inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+size_t percentDecodeInto(std::string_view in, char* out) {
+    const char* p = in.data();
+    const char* end = p + in.size();
+    char* w = out;
+
+    while (p < end) {
+        // Copy the run up to the next escape in one go
+        const char* pct = findByte(p, end, '%');
+        size_t run = static_cast<size_t>(pct - p);
+        if (w != p) std::memmove(w, p, run);
+        w += run;
+        p = pct;
+        if (p == end) break;
+
+        // An escape needs two hex digits after the '%'
+        int hi = (end - p >= 3) ? hexValue(p[1]) : -1;
+        int lo = (hi >= 0) ? hexValue(p[2]) : -1;
+        if (lo >= 0) {
+            *w++ = static_cast<char>((hi << 4) | lo);
+            p += 3;
+        } else {
+            *w++ = *p++;
+        }
+    }
+    return static_cast<size_t>(w - out);
+}
+
+void percentDecode(std::string_view in, std::string& dst) {
+    dst.resize(in.size());
+    if (in.empty()) return;
+    dst.resize(percentDecodeInto(in, &dst[0]));
+}
+
+// ---------------------- Number Parsing ----------------------
+bool parseUint64(std::string_view s, uint64_t& value) {
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
+
+bool parseInt(std::string_view s, int& value) {
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
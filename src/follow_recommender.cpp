@@ -0,0 +1,87 @@
+#include "follow_recommender.h"
+#include <algorithm>
+#include <cmath>
+
+FollowRecommender::Tally& FollowRecommender::tallyFor(UserIdx idx) {
+    if (idx >= tallies.size()) {
+        tallies.resize(std::max<size_t>(idx + 1, tallies.size() * 2), Tally{0.0f, 0});
+    }
+    return tallies[idx];
+}
+
+// engagement is sorted by author
+uint32_t FollowRecommender::likesOf(UserIdx author) const {
+    auto it = std::lower_bound(engagement.begin(), engagement.end(), author,
+                               [](const AuthorAffinity::Entry& e, UserIdx a) { return e.author < a; });
+    return (it != engagement.end() && it->author == author) ? it->likes : 0;
+}
+
+// Keep limit evenly spaced members, in place and still sorted. The start
+// within the first stride comes from seed.
+void FollowRecommender::sample(std::vector<UserIdx>& list, size_t limit, uint64_t seed) {
+    size_t n = list.size();
+    if (n <= limit) return;
+    size_t offset = seed % (n / limit);
+    for (size_t i = 0; i < limit; ++i) {
+        list[i] = list[i * n / limit + offset];
+    }
+    list.resize(limit);
+}
+
+void FollowRecommender::recommend(const SocialGraph& graph, const AuthorAffinity* affinity,
+                                  UserIdx user, size_t k, std::vector<FollowSuggestion>& out) {
+    out.clear();
+    if (k == 0) return;
+
+    graph.following(user, following);
+    sources = following;
+    sample(sources, MAX_FOLLOWING, user);
+    float sourceScale = sources.empty() ? 0.0f : static_cast<float>(following.size()) / sources.size();
+
+    engagement.clear();
+    if (affinity) affinity->copyFor(user, engagement);
+
+    auto credit = [&](UserIdx candidate, float weight, uint32_t paths) {
+        Tally& t = tallyFor(candidate);
+        if (t.score == 0.0f) touched.push_back(candidate);
+        t.score += weight;
+        t.mutuals += paths;
+    };
+
+    for (UserIdx source : sources) {
+        graph.following(source, fanout);
+        size_t degree = fanout.size();
+        sample(fanout, MAX_FANOUT, (static_cast<uint64_t>(user) << 32) ^ source);
+        if (fanout.empty()) continue;
+
+        float weight = sourceScale * static_cast<float>(degree) / fanout.size();
+        if (affinity) weight *= 1.0f + ENGAGEMENT_WEIGHT * std::log1p(static_cast<float>(likesOf(source)));
+        for (UserIdx candidate : fanout) {
+            if (candidate != user) credit(candidate, weight, 1);
+        }
+    }
+    for (const AuthorAffinity::Entry& e : engagement) {
+        if (e.author != user) credit(e.author, ENGAGEMENT_WEIGHT * std::log1p(static_cast<float>(e.likes)), 0);
+    }
+
+    for (UserIdx candidate : touched) {
+        Tally& t = tallies[candidate];
+        if (!std::binary_search(following.begin(), following.end(), candidate)) {
+            out.push_back(FollowSuggestion{candidate, t.mutuals, t.score});
+        }
+        t = Tally{0.0f, 0};
+    }
+    touched.clear();
+
+    auto better = [](const FollowSuggestion& a, const FollowSuggestion& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.mutuals != b.mutuals) return a.mutuals > b.mutuals;
+        return a.user < b.user;
+    };
+    if (out.size() > k) {
+        std::partial_sort(out.begin(), out.begin() + k, out.end(), better);
+        out.resize(k);
+    } else {
+        std::sort(out.begin(), out.end(), better);
+    }
+}
@@ -0,0 +1,211 @@
+#include "graph_analytics.h"
+#include <algorithm>
+#include <iterator>
+
+// ---------------------- Summary ----------------------
+static size_t bucketOf(size_t degree) {
+    size_t b = 0;
+    while (degree) {
+        ++b;
+        degree >>= 1;
+    }
+    return b;
+}
+
+static void countDegree(DegreeHistogram& h, UserIdx u, size_t degree) {
+    size_t b = bucketOf(degree);
+    if (b >= h.buckets.size()) h.buckets.resize(b + 1, 0);
+    h.buckets[b]++;
+    if (degree > h.maxDegree) {
+        h.maxDegree = static_cast<uint32_t>(degree);
+        h.maxUser = u;
+    }
+}
+
+static void mergeHistogram(DegreeHistogram& into, const DegreeHistogram& part) {
+    if (part.buckets.size() > into.buckets.size()) into.buckets.resize(part.buckets.size(), 0);
+    for (size_t b = 0; b < part.buckets.size(); ++b) into.buckets[b] += part.buckets[b];
+    if (part.maxDegree > into.maxDegree) {
+        into.maxDegree = part.maxDegree;
+        into.maxUser = part.maxUser;
+    }
+}
+
+GraphSummary summarizeGraph(const SocialGraph& graph, size_t vertexCount, ThreadPool& pool) {
+    struct Partial {
+        DegreeHistogram following, followers;
+        size_t edges = 0;
+        size_t reciprocal = 0;      // followees who follow back, so each pair twice
+    };
+    const size_t parts = pool.size() * 4;
+    std::vector<Partial> partials(parts);
+
+    parallelFor(pool, parts, [&](size_t p) {
+        Partial& part = partials[p];
+        std::vector<UserIdx> out, in;
+        size_t end = vertexCount * (p + 1) / parts;
+        for (size_t u = vertexCount * p / parts; u < end; ++u) {
+            UserIdx idx = static_cast<UserIdx>(u);
+            graph.following(idx, out);
+            graph.followers(idx, in);
+            countDegree(part.following, idx, out.size());
+            countDegree(part.followers, idx, in.size());
+            part.edges += out.size();
+
+            size_t i = 0, j = 0;
+            while (i < out.size() && j < in.size()) {
+                if (out[i] < in[j]) {
+                    ++i;
+                } else if (in[j] < out[i]) {
+                    ++j;
+                } else {
+                    part.reciprocal++;
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+    });
+
+    GraphSummary s;
+    s.users = vertexCount;
+    size_t reciprocal = 0;
+    for (const Partial& part : partials) {
+        mergeHistogram(s.following, part.following);
+        mergeHistogram(s.followers, part.followers);
+        s.edges += part.edges;
+        reciprocal += part.reciprocal;
+    }
+    s.reciprocalPairs = reciprocal / 2;
+    if (s.edges > 0) s.reciprocity = static_cast<double>(reciprocal) / s.edges;
+    if (vertexCount > 0) {
+        s.following.mean = static_cast<double>(s.edges) / vertexCount;
+        s.followers.mean = s.following.mean;
+    }
+    return s;
+}
+
+void mutualFollowers(const SocialGraph& graph, UserIdx a, UserIdx b, std::vector<UserIdx>& out) {
+    std::vector<UserIdx> ofA, ofB;
+    graph.followers(a, ofA);
+    graph.followers(b, ofB);
+    out.clear();
+    std::set_intersection(ofA.begin(), ofA.end(), ofB.begin(), ofB.end(), std::back_inserter(out));
+}
+
+// ---------------------- Breadth-First Search ----------------------
+using Bitset = std::vector<uint64_t>;
+
+// Frontiers smaller than this are expanded on the calling thread
+static constexpr size_t PARALLEL_FRONTIER = 4096;
+
+static bool testBit(const Bitset& bits, UserIdx v) {
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+static void setBit(Bitset& bits, UserIdx v) {
+    bits[v >> 6] |= uint64_t(1) << (v & 63);
+}
+
+static bool intersects(const Bitset& a, const Bitset& b) {
+    for (size_t w = 0; w < a.size(); ++w) {
+        if (a[w] & b[w]) return true;
+    }
+    return false;
+}
+
+// One BFS level: the unvisited neighbours of frontier (followees going
+// forward, followers going backward) become next and are marked visited.
+// Workers only read visited while they collect candidates; marking is
+// done afterwards on this thread. Returns the size of next.
+static size_t expand(const SocialGraph& graph, bool forward, const Bitset& frontier, size_t frontierSize,
+                     Bitset& visited, Bitset& next, ThreadPool& pool) {
+    const size_t limit = visited.size() * 64;
+    auto scan = [&](size_t wordBegin, size_t wordEnd, std::vector<UserIdx>& found) {
+        std::vector<UserIdx> neighbours;
+        for (size_t w = wordBegin; w < wordEnd; ++w) {
+            for (uint64_t bits = frontier[w]; bits != 0; bits &= bits - 1) {
+                UserIdx u = static_cast<UserIdx>(w * 64 + __builtin_ctzll(bits));
+                if (forward) {
+                    graph.following(u, neighbours);
+                } else {
+                    graph.followers(u, neighbours);
+                }
+                for (UserIdx v : neighbours) {
+                    if (v < limit && !testBit(visited, v)) found.push_back(v);
+                }
+            }
+        }
+    };
+
+    std::vector<std::vector<UserIdx>> found;
+    if (frontierSize < PARALLEL_FRONTIER || pool.size() < 2) {
+        found.resize(1);
+        scan(0, frontier.size(), found[0]);
+    } else {
+        const size_t parts = pool.size() * 4;
+        found.resize(parts);
+        parallelFor(pool, parts, [&](size_t p) {
+            scan(frontier.size() * p / parts, frontier.size() * (p + 1) / parts, found[p]);
+        });
+    }
+
+    std::fill(next.begin(), next.end(), 0);
+    size_t added = 0;
+    for (const std::vector<UserIdx>& list : found) {
+        for (UserIdx v : list) {
+            if (!testBit(visited, v)) {
+                setBit(visited, v);
+                setBit(next, v);
+                added++;
+            }
+        }
+    }
+    return added;
+}
+
+int degreesOfSeparation(const SocialGraph& graph, size_t vertexCount, UserIdx from, UserIdx to,
+                        int maxDepth, ThreadPool& pool) {
+    if (from >= vertexCount || to >= vertexCount) return -1;
+    if (from == to) return 0;
+
+    const size_t words = (vertexCount + 63) / 64;
+    Bitset seenFrom(words, 0), seenTo(words, 0), frontFrom(words, 0), frontTo(words, 0), next(words, 0);
+    setBit(seenFrom, from);
+    setBit(frontFrom, from);
+    setBit(seenTo, to);
+    setBit(frontTo, to);
+    size_t sizeFrom = 1, sizeTo = 1;
+
+    // Levels so far had no vertex in common, so the first one found closes
+    // a shortest path of depth hops
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        bool forward = sizeFrom <= sizeTo;
+        Bitset& front = forward ? frontFrom : frontTo;
+        size_t& size = forward ? sizeFrom : sizeTo;
+        size = expand(graph, forward, front, size, forward ? seenFrom : seenTo, next, pool);
+        if (size == 0) return -1;
+        if (intersects(next, forward ? seenTo : seenFrom)) return depth;
+        front.swap(next);
+    }
+    return -1;
+}
+
+void reachByDistance(const SocialGraph& graph, size_t vertexCount, UserIdx from, int maxDepth,
+                     ThreadPool& pool, std::vector<size_t>& counts) {
+    counts.clear();
+    if (from >= vertexCount) return;
+
+    const size_t words = (vertexCount + 63) / 64;
+    Bitset seen(words, 0), front(words, 0), next(words, 0);
+    setBit(seen, from);
+    setBit(front, from);
+    counts.push_back(1);
+
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        size_t found = expand(graph, true, front, counts.back(), seen, next, pool);
+        if (found == 0) break;
+        counts.push_back(found);
+        front.swap(next);
+    }
+}
@@ -0,0 +1,56 @@
+#include "id_interner.h"
+#include <mutex>
+#include <stdexcept>
+
+uint32_t IdInterner::intern(std::string_view id) {
+    {
+        std::shared_lock<ShardedSharedMutex> lock(tableMutex);
+        auto it = indexOf.find(id);
+        if (it != indexOf.end()) return it->second;
+    }
+
+    std::unique_lock<ShardedSharedMutex> lock(tableMutex);
+    // Another thread may have added it between the two locks
+    auto it = indexOf.find(id);
+    if (it != indexOf.end()) return it->second;
+
+    if (names.size() >= INVALID_IDX) {
+        throw std::overflow_error("ID table is full");
+    }
+    uint32_t idx = static_cast<uint32_t>(names.size());
+    names.emplace_back(id);
+    indexOf.emplace(names.back(), idx);
+    return idx;
+}
+
+uint32_t IdInterner::find(std::string_view id) const {
+    std::shared_lock<ShardedSharedMutex> lock(tableMutex);
+    auto it = indexOf.find(id);
+    return (it != indexOf.end()) ? it->second : INVALID_IDX;
+}
+
+const std::string& IdInterner::name(uint32_t idx) const {
+    static const std::string empty;
+    std::shared_lock<ShardedSharedMutex> lock(tableMutex);
+    return (idx < names.size()) ? names[idx] : empty;
+}
+
+size_t IdInterner::size() const {
+    std::shared_lock<ShardedSharedMutex> lock(tableMutex);
+    return names.size();
+}
+
+void IdInterner::reserve(size_t count) {
+    std::unique_lock<ShardedSharedMutex> lock(tableMutex);
+    indexOf.reserve(count);
+}
+
+IdInterner& userIdTable() {
+    static IdInterner table;
+    return table;
+}
+
+IdInterner& postIdTable() {
+    static IdInterner table;
+    return table;
+}
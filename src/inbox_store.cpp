@@ -0,0 +1,91 @@
+#include "inbox_store.h"
+#include <algorithm>
+
+InboxStore::InboxStore(size_t ringCapacity)
+    : capacity(1), ringCount(0) {
+    while (capacity < ringCapacity) capacity <<= 1;
+}
+
+void InboxStore::ensureUser(UserIdx idx) {
+    if (idx >= headers.size()) {
+        headers.resize(idx + 1, Header{NO_RING, 0, 0});
+    }
+}
+
+// ---------------------- Slabs ----------------------
+uint32_t InboxStore::allocateRing() {
+    if (!freeRings.empty()) {
+        uint32_t ring = freeRings.back();
+        freeRings.pop_back();
+        return ring;
+    }
+    if (ringCount % SLAB_RINGS == 0) {
+        slabs.emplace_back(new PostIdx[SLAB_RINGS * capacity]);
+    }
+    return ringCount++;
+}
+
+// ---------------------- Inboxes ----------------------
+void InboxStore::push(UserIdx user, PostIdx post) {
+    ensureUser(user);
+    Header& h = headers[user];
+    if (h.ring == NO_RING) h.ring = allocateRing();
+
+    ringData(h.ring)[h.pushed % capacity] = post;
+    h.pushed++;
+    // Keep the read mark within the ring so unread never exceeds capacity
+    if (h.pushed - h.seen > capacity) h.seen = h.pushed - static_cast<uint32_t>(capacity);
+}
+
+size_t InboxStore::unreadCount(UserIdx user) const {
+    if (user >= headers.size()) return 0;
+    return headers[user].pushed - headers[user].seen;
+}
+
+size_t InboxStore::size(UserIdx user) const {
+    if (user >= headers.size() || headers[user].ring == NO_RING) return 0;
+    return std::min<size_t>(headers[user].pushed, capacity);
+}
+
+void InboxStore::recent(UserIdx user, size_t limit, bool unreadOnly, std::vector<PostIdx>& out) const {
+    out.clear();
+    if (user >= headers.size() || headers[user].ring == NO_RING) return;
+
+    const Header& h = headers[user];
+    size_t available = unreadOnly ? h.pushed - h.seen : std::min<size_t>(h.pushed, capacity);
+    size_t n = std::min(limit, available);
+    const PostIdx* ring = ringData(h.ring);
+    out.reserve(n);
+    for (size_t i = 1; i <= n; ++i) {
+        out.push_back(ring[(h.pushed - i) % capacity]);
+    }
+}
+
+void InboxStore::markAllRead(UserIdx user) {
+    if (user < headers.size()) headers[user].seen = headers[user].pushed;
+}
+
+void InboxStore::reset(UserIdx user) {
+    if (user >= headers.size()) return;
+    Header& h = headers[user];
+    if (h.ring != NO_RING) freeRings.push_back(h.ring);
+    h = Header{NO_RING, 0, 0};
+}
+
+void InboxStore::clear() {
+    headers.clear();
+    slabs.clear();
+    freeRings.clear();
+    ringCount = 0;
+}
+
+InboxStats InboxStore::stats() const {
+    InboxStats s;
+    s.users = headers.size();
+    s.activeInboxes = ringCount - freeRings.size();
+    s.slabs = slabs.size();
+    s.bytes = headers.capacity() * sizeof(Header) +
+              slabs.size() * SLAB_RINGS * capacity * sizeof(PostIdx) +
+              freeRings.capacity() * sizeof(uint32_t);
+    return s;
+}
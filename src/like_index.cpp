@@ -0,0 +1,64 @@
+#include "like_index.h"
+#include <algorithm>
+
+bool LikeIndex::add(PostIdx post, UserIdx user) {
+    Shard& shard = shardFor(post);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.likers[post].insert(user);
+}
+
+bool LikeIndex::contains(PostIdx post, UserIdx user) const {
+    const Shard& shard = shardFor(post);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.likers.find(post);
+    return it != shard.likers.end() && it->second.contains(user);
+}
+
+void LikeIndex::bulkLoad(std::vector<std::pair<PostIdx, UserIdx>> likes) {
+    clear();
+    std::sort(likes.begin(), likes.end());
+
+    std::vector<UserIdx> users;
+    size_t i = 0;
+    while (i < likes.size()) {
+        PostIdx post = likes[i].first;
+        users.clear();
+        for (; i < likes.size() && likes[i].first == post; ++i) {
+            users.push_back(likes[i].second);
+        }
+        Shard& shard = shardFor(post);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.likers[post].assign(users);
+    }
+}
+
+void LikeIndex::copyTo(std::unordered_map<PostIdx, std::vector<UserIdx>>& out) const {
+    out.clear();
+    for (const Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& entry : shard.likers) {
+            IdView view = entry.second.view();
+            std::vector<UserIdx>& users = out[entry.first];
+            users.assign(view.begin(), view.end());
+            std::sort(users.begin(), users.end());
+        }
+    }
+}
+
+size_t LikeIndex::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& entry : shard.likers) {
+            total += entry.second.size();
+        }
+    }
+    return total;
+}
+
+void LikeIndex::clear() {
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.likers.clear();
+    }
+}
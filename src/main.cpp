@@ -4,10 +4,14 @@
 #include <iostream>
 #include <limits>
 #include <clocale>
+#include <thread>
 
 // Current logged-in user
 std::string currentUserID = "";
 
+// Posts fetched per feed page
+const size_t FEED_PAGE_SIZE = 10;
+
 void clearScreen() {
 #ifdef _WIN32
     system("cls");
@@ -57,8 +61,7 @@ bool signup() {
     User newUser(userID, username, name, bio);
 
     if (core.addUser(newUser)) {
-        // persist immediately
-        core.saveAllData();
+        // addUser logs the change durably, no full save needed
         std::cout << "Account created successfully! Your ID: " << userID << "\n";
         return true;
     }
@@ -76,18 +79,16 @@ bool login() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
     SystemCore& core = SystemCore::getInstance();
-    std::vector<User> allUsers = core.getAllUsers();
+    std::shared_ptr<const User> user = core.findUserByUsername(username);
 
-    for (const User& u : allUsers) {
-        if (u.getUsername() == username) {
-            currentUserID = u.getUserID();
-            std::cout << " Welcome back, " << u.getName() << "!\n";
-            return true;
-        }
+    if (!user) {
+        std::cout << " User not found!\n";
+        return false;
     }
 
-    std::cout << " User not found!\n";
-    return false;
+    currentUserID = user->getUserID();
+    std::cout << " Welcome back, " << user->getName() << "!\n";
+    return true;
 }
 
 void createPost() {
@@ -112,8 +113,6 @@ void createPost() {
     Post newPost(core.generatePostID(), currentUserID, content, currentTimestamp());
 
     if (core.addPost(newPost)) {
-        // persist immediately
-        core.saveAllData();
         std::cout << " Post created successfully!\n";
     } else {
         std::cout << " Failed to create post.\n";
@@ -127,16 +126,17 @@ void viewMyPosts() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    std::vector<Post> myPosts = core.getPostsByUser(currentUserID);
+    std::vector<PostIdx> myPosts = core.getPostIndexByUser(currentUserID);
 
     if (myPosts.empty()) {
         std::cout << "\n You haven't posted anything yet.\n";
         return;
     }
 
+    // Newest first
     std::cout << "\n═══════════════ MY POSTS ═══════════════\n";
-    for (const Post& p : myPosts) {
-        p.display();
+    for (auto it = myPosts.rbegin(); it != myPosts.rend(); ++it) {
+        core.getPostByIdx(*it)->display();
         std::cout << "────────────────────────────────────\n";
     }
 }
@@ -148,20 +148,36 @@ void followUser() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    std::vector<User> allUsers = core.getAllUsers();
-
-    std::cout << "\n--- Available Users ---\n";
-    int index = 1;
-    for (const User& u : allUsers) {
-        if (u.getUserID() != currentUserID) {
-            std::cout << index++ << ". @" << u.getUsername()
-                      << " - " << u.getName() << "\n";
+    std::vector<FollowRecommendation> suggested = core.recommendFollows(currentUserID, FEED_PAGE_SIZE);
+
+    if (!suggested.empty()) {
+        std::cout << "\n--- Suggested For You ---\n";
+        int index = 1;
+        for (const FollowRecommendation& s : suggested) {
+            std::cout << index++ << ". @" << s.user->getUsername() << " - " << s.user->getName();
+            if (s.mutuals > 0) {
+                std::cout << " (followed by " << s.mutuals << " you follow)";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "(or enter any username)\n";
+    } else {
+        // Nothing to go on yet (no follows or likes), so list everyone
+        std::vector<std::shared_ptr<const User>> allUsers = core.getUserList();
+
+        std::cout << "\n--- Available Users ---\n";
+        int index = 1;
+        for (const auto& u : allUsers) {
+            if (u->getUserID() != currentUserID) {
+                std::cout << index++ << ". @" << u->getUsername()
+                          << " - " << u->getName() << "\n";
+            }
         }
-    }
 
-    if (index == 1) {
-        std::cout << " No other users found.\n";
-        return;
+        if (index == 1) {
+            std::cout << " No other users found.\n";
+            return;
+        }
     }
 
     std::string username;
@@ -169,19 +185,17 @@ void followUser() {
     std::cin >> username;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-    for (const User& u : allUsers) {
-        if (u.getUsername() == username) {
-            if (core.followUser(currentUserID, u.getUserID())) {
-                core.saveAllData();
-                std::cout << " You are now following @" << username << "\n";
-            } else {
-                std::cout << " Failed to follow user.\n";
-            }
-            return;
-        }
+    std::shared_ptr<const User> target = core.findUserByUsername(username);
+    if (!target) {
+        std::cout << " User not found.\n";
+        return;
     }
 
-    std::cout << " User not found.\n";
+    if (core.followUser(currentUserID, target->getUserID())) {
+        std::cout << " You are now following @" << username << "\n";
+    } else {
+        std::cout << " Failed to follow user.\n";
+    }
 }
 
 void unfollowUser() {
@@ -191,11 +205,11 @@ void unfollowUser() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    User* currentUser = core.getUser(currentUserID);
+    std::shared_ptr<const User> currentUser = core.getUser(currentUserID);
 
     if (!currentUser) return;
 
-    std::vector<std::string> following = currentUser->getFollowing();
+    std::vector<std::string> following = core.getFollowingIDs(currentUserID);
 
     if (following.empty()) {
         std::cout << "\n You are not following anyone.\n";
@@ -205,7 +219,7 @@ void unfollowUser() {
     std::cout << "\n--- Following ---\n";
     int index = 1;
     for (const std::string& uid : following) {
-        User* u = core.getUser(uid);
+        std::shared_ptr<const User> u = core.getUser(uid);
         if (u) {
             std::cout << index++ << ". @" << u->getUsername() << "\n";
         }
@@ -217,10 +231,9 @@ void unfollowUser() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
     for (const std::string& uid : following) {
-        User* u = core.getUser(uid);
+        std::shared_ptr<const User> u = core.getUser(uid);
         if (u && u->getUsername() == username) {
             if (core.unfollowUser(currentUserID, uid)) {
-                core.saveAllData();
                 std::cout << " You unfollowed @" << username << "\n";
             } else {
                 std::cout << " Failed to unfollow user.\n";
@@ -239,15 +252,28 @@ void viewFeed() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    std::vector<Post> feedPosts = core.generateFeedForUser(currentUserID);
+    FeedPage page = core.getFeedPage(currentUserID, FEED_PAGE_SIZE);
 
-    TextFeed<Post> feed;
-    for (const Post& p : feedPosts) {
-        feed.addPost(p);
+    if (page.posts.empty()) {
+        std::cout << "\n📭 Your feed is empty. Follow some users to see their posts!\n";
+        return;
     }
 
-    feed.sortByTimestamp(true); // Newest first
-    feed.displayFeed();
+    std::cout << "\n═══════════════ FEED ═══════════════\n";
+    while (true) {
+        for (const PostRef& p : page.posts) {
+            p->display();
+            std::cout << "────────────────────────────────────\n";
+        }
+        if (page.nextCursor.empty()) break;
+
+        std::cout << "Show older posts? (y/n): ";
+        std::string answer;
+        std::getline(std::cin, answer);
+        if (answer != "y" && answer != "Y") break;
+
+        page = core.getFeedPage(currentUserID, FEED_PAGE_SIZE, page.nextCursor);
+    }
 }
 
 void viewProfile() {
@@ -257,10 +283,10 @@ void viewProfile() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    User* user = core.getUser(currentUserID);
+    std::shared_ptr<const User> user = core.getUser(currentUserID);
 
     if (user) {
-        user->displayProfile();
+        user->displayProfile(core.getFollowerCount(currentUserID), core.getFollowingCount(currentUserID));
     }
 }
 
@@ -271,7 +297,7 @@ void editProfile() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    User* user = core.getUser(currentUserID);
+    std::shared_ptr<const User> user = core.getUser(currentUserID);
 
     if (!user) return;
 
@@ -288,15 +314,13 @@ void editProfile() {
         std::string newName;
         std::cout << "Enter new name: ";
         std::getline(std::cin, newName);
-        user->setName(newName);
-        core.saveAllData();
+        core.updateUserName(currentUserID, newName);
         std::cout << " Name updated!\n";
     } else if (choice == 2) {
         std::string newBio;
         std::cout << "Enter new bio: ";
         std::getline(std::cin, newBio);
-        user->setBio(newBio);
-        core.saveAllData();
+        core.updateUserBio(currentUserID, newBio);
         std::cout << " Bio updated!\n";
     }
 }
@@ -308,29 +332,41 @@ void likePost() {
     }
 
     SystemCore& core = SystemCore::getInstance();
-    std::vector<Post> feedPosts = core.generateFeedForUser(currentUserID);
+    FeedPage page = core.getFeedPage(currentUserID, FEED_PAGE_SIZE);
+    std::vector<PostRef> feedPosts;
 
-    if (feedPosts.empty()) {
+    if (page.posts.empty()) {
         std::cout << "\n No posts in your feed.\n";
         return;
     }
 
+    // Numbers keep counting across pages so earlier posts stay selectable
     std::cout << "\n--- Posts in Feed ---\n";
-    for (size_t i = 0; i < feedPosts.size(); ++i) {
-        std::cout << "\n[" << (i + 1) << "]\n";
-        feedPosts[i].display();
-    }
-
-    std::cout << "\nEnter post number to like: ";
     int choice;
-    std::cin >> choice;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    while (true) {
+        for (const PostRef& p : page.posts) {
+            feedPosts.push_back(p);
+            std::cout << "\n[" << feedPosts.size() << "]\n";
+            p->display();
+        }
+
+        if (page.nextCursor.empty()) {
+            std::cout << "\nEnter post number to like: ";
+        } else {
+            std::cout << "\nEnter post number to like (0 for older posts): ";
+        }
+        std::cin >> choice;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        if (choice != 0 || page.nextCursor.empty()) break;
+        page = core.getFeedPage(currentUserID, FEED_PAGE_SIZE, page.nextCursor);
+    }
 
     if (choice > 0 && choice <= static_cast<int>(feedPosts.size())) {
-        Post* post = core.getPost(feedPosts[choice - 1].getPostID());
-        if (post) {
-            post->like();
-            core.saveAllData();
+        const std::string& postID = feedPosts[choice - 1]->getPostID();
+        if (core.hasLiked(currentUserID, postID)) {
+            std::cout << " You already liked this post.\n";
+        } else if (core.likePost(currentUserID, postID)) {
             std::cout << " Post liked!\n";
         } else {
             std::cout << " Post not found.\n";
@@ -340,20 +376,187 @@ void likePost() {
     }
 }
 
+void viewTopPosts() {
+    if (currentUserID.empty()) {
+        std::cout << " You must be logged in.\n";
+        return;
+    }
+
+    SystemCore& core = SystemCore::getInstance();
+    std::vector<PostRef> posts = core.generateRankedFeedForUser(currentUserID, FEED_PAGE_SIZE);
+
+    if (posts.empty()) {
+        std::cout << "\n📭 Your feed is empty. Follow some users to see their posts!\n";
+        return;
+    }
+
+    std::cout << "\n═══════════════ TOP POSTS ═══════════════\n";
+    for (const PostRef& p : posts) {
+        p->display();
+        std::cout << "────────────────────────────────────\n";
+    }
+}
+
+void viewTrending() {
+    SystemCore& core = SystemCore::getInstance();
+    const TrendWindow windows[] = {TrendWindow::LastHour, TrendWindow::LastDay};
+    const char* titles[] = {"Last Hour", "Last 24 Hours"};
+
+    std::cout << "\n═══════════════ TRENDING ═══════════════\n";
+    for (size_t w = 0; w < 2; ++w) {
+        std::vector<TrendingTag> tags = core.getTrending(windows[w], FEED_PAGE_SIZE);
+        std::cout << "\n" << titles[w] << ":\n";
+        if (tags.empty()) {
+            std::cout << "  (no hashtags yet)\n";
+        }
+        for (size_t i = 0; i < tags.size(); ++i) {
+            std::cout << "  " << i + 1 << ". #" << tags[i].tag << " (" << tags[i].count << ")\n";
+        }
+    }
+}
+
+// "@prefix" looks up usernames; otherwise every word must match, or any
+// word when the query contains OR
+void searchAll() {
+    SystemCore& core = SystemCore::getInstance();
+    std::string query;
+    std::cout << "Search (words, or @username prefix): ";
+    std::getline(std::cin, query);
+
+    if (!query.empty() && query[0] == '@') {
+        std::vector<std::shared_ptr<const User>> found = core.findUsersByPrefix(query.substr(1), FEED_PAGE_SIZE);
+        if (found.empty()) {
+            std::cout << " No users found.\n";
+            return;
+        }
+        std::cout << "\n--- Users ---\n";
+        for (const auto& u : found) {
+            std::cout << "@" << u->getUsername() << " (" << u->getName() << ")\n";
+        }
+        return;
+    }
+
+    SearchMode mode = SearchMode::All;
+    size_t orPos = query.find(" OR ");
+    while (orPos != std::string::npos) {
+        mode = SearchMode::Any;
+        query.replace(orPos, 4, " ");
+        orPos = query.find(" OR ");
+    }
+
+    std::vector<std::shared_ptr<const User>> users = core.searchUsers(query, mode, FEED_PAGE_SIZE);
+    std::vector<PostRef> posts = core.searchPosts(query, mode, PostOrder::Newest, FEED_PAGE_SIZE);
+    if (users.empty() && posts.empty()) {
+        std::cout << " Nothing found.\n";
+        return;
+    }
+
+    if (!users.empty()) {
+        std::cout << "\n--- Users ---\n";
+        for (const auto& u : users) {
+            std::cout << "@" << u->getUsername() << " (" << u->getName() << ")\n";
+        }
+    }
+    if (!posts.empty()) {
+        std::cout << "\n--- Posts ---\n";
+        for (const PostRef& p : posts) {
+            p->display();
+            std::cout << "────────────────────────────────────\n";
+        }
+    }
+}
+
+void viewNotifications() {
+    if (currentUserID.empty()) {
+        std::cout << " You must be logged in.\n";
+        return;
+    }
+
+    SystemCore& core = SystemCore::getInstance();
+    size_t unread = core.getUnreadCount(currentUserID);
+    std::vector<PostRef> posts = core.getInbox(currentUserID, FEED_PAGE_SIZE);
+
+    if (posts.empty()) {
+        std::cout << "\n No notifications yet.\n";
+        return;
+    }
+
+    std::cout << "\n--- Notifications (" << unread << " new) ---\n";
+    for (size_t i = 0; i < posts.size(); ++i) {
+        if (i == unread && unread > 0) std::cout << "\n--- Earlier ---\n";
+        posts[i]->display();
+    }
+    core.markInboxRead(currentUserID);
+}
+
 void showStatistics() {
     SystemCore& core = SystemCore::getInstance();
 
     std::cout << "\n═══════════════ STATISTICS ═══════════════\n";
     std::cout << "Total Users: " << core.getUserCount() << "\n";
     std::cout << "Total Posts: " << core.getPostCount() << "\n";
+    std::cout << "Total Likes: " << core.getTotalLikes() << "\n";
+
+    std::vector<PostIdx> top = core.getTopPosts(1, PostOrder::MostLiked);
+    std::shared_ptr<const Post> mostLiked = top.empty() ? nullptr : core.getPostByIdx(top[0]);
+    if (mostLiked && mostLiked->getLikes() > 0) {
+        std::cout << "Most Liked Post: " << mostLiked->getPostID() << " ("
+                  << mostLiked->getLikes() << " likes)\n";
+    }
+
+    GraphSummary graph = core.getGraphSummary();
+    std::cout << "\nFollow Graph:\n";
+    std::cout << "Follows: " << graph.edges << " (" << graph.reciprocalPairs << " mutual pairs, "
+              << static_cast<int>(graph.reciprocity * 100 + 0.5) << "% followed back)\n";
+    std::cout << "Followers per user (average " << static_cast<int>(graph.followers.mean * 10 + 0.5) / 10.0
+              << ", most " << graph.followers.maxDegree << "):\n";
+    for (size_t b = 0; b < graph.followers.buckets.size(); ++b) {
+        if (graph.followers.buckets[b] == 0) continue;
+        uint32_t low = DegreeHistogram::bucketLow(b), high = DegreeHistogram::bucketHigh(b);
+        std::cout << "  " << low;
+        if (high > low) std::cout << "-" << high;
+        std::cout << ": " << graph.followers.buckets[b] << (graph.followers.buckets[b] == 1 ? " user\n" : " users\n");
+    }
 
     if (!currentUserID.empty()) {
-        User* user = core.getUser(currentUserID);
+        std::shared_ptr<const User> user = core.getUser(currentUserID);
         if (user) {
             std::cout << "\nYour Stats:\n";
-            std::cout << "Followers: " << user->getFollowerCount() << "\n";
-            std::cout << "Following: " << user->getFollowingCount() << "\n";
-            std::cout << "Posts: " << core.getPostsByUser(currentUserID).size() << "\n";
+            std::cout << "Followers: " << core.getFollowerCount(currentUserID) << "\n";
+            std::cout << "Following: " << core.getFollowingCount(currentUserID) << "\n";
+            std::cout << "Posts: " << core.getPostCountByUser(currentUserID) << "\n";
+
+            std::vector<size_t> reach = core.getReachByDistance(currentUserID, 3);
+            if (reach.size() > 1) {
+                std::cout << "Reach:";
+                for (size_t d = 1; d < reach.size(); ++d) {
+                    std::cout << (d > 1 ? "," : "") << " " << reach[d] << " at " << d << (d == 1 ? " hop" : " hops");
+                }
+                std::cout << "\n";
+            }
+
+            std::string username;
+            std::cout << "\nCompare with username (Enter to skip): ";
+            std::getline(std::cin, username);
+            std::shared_ptr<const User> other = username.empty() ? nullptr : core.findUserByUsername(username);
+            if (other) {
+                std::vector<std::shared_ptr<const User>> mutual =
+                    core.getMutualFollowers(currentUserID, other->getUserID());
+                std::cout << "Followed by both of you: " << mutual.size();
+                for (size_t i = 0; i < mutual.size() && i < 5; ++i) {
+                    std::cout << (i == 0 ? " (" : ", ") << "@" << mutual[i]->getUsername();
+                }
+                std::cout << (mutual.size() > 5 ? ", ...)" : mutual.empty() ? "" : ")") << "\n";
+
+                int hops = core.getDegreesOfSeparation(currentUserID, other->getUserID());
+                if (hops < 0) {
+                    std::cout << "Separation: more than " << SystemCore::DEFAULT_SEPARATION_DEPTH << " hops\n";
+                } else {
+                    std::cout << "Separation: " << hops << (hops == 1 ? " hop" : " hops") << "\n";
+                }
+            } else if (!username.empty()) {
+                std::cout << " User not found.\n";
+            }
         }
     }
     std::cout << "═══════════════════════════════════════════\n";
@@ -394,7 +597,7 @@ void mainMenu() {
             }
         } else {
             SystemCore& core = SystemCore::getInstance();
-            User* user = core.getUser(currentUserID);
+            std::shared_ptr<const User> user = core.getUser(currentUserID);
 
             if (!user) {
                 // If user was deleted or not found, force logout
@@ -402,7 +605,12 @@ void mainMenu() {
                 continue;
             }
 
-            std::cout << "\n👤 Logged in as: @" << user->getUsername() << "\n";
+            std::cout << "\n👤 Logged in as: @" << user->getUsername();
+            size_t unread = core.getUnreadCount(currentUserID);
+            if (unread > 0) {
+                std::cout << "  (" << unread << " new notification" << (unread == 1 ? "" : "s") << ")";
+            }
+            std::cout << "\n";
             std::cout << "\n--- Menu ---\n";
             std::cout << "1. Create Post\n";
             std::cout << "2. View My Posts\n";
@@ -414,6 +622,10 @@ void mainMenu() {
             std::cout << "8. Edit Profile\n";
             std::cout << "9. Statistics\n";
             std::cout << "10. Logout\n";
+            std::cout << "11. Notifications\n";
+            std::cout << "12. Top Posts\n";
+            std::cout << "13. Trending Hashtags\n";
+            std::cout << "14. Search\n";
             std::cout << "Choice: ";
 
             int choice;
@@ -462,6 +674,22 @@ void mainMenu() {
                     std::cout << " Logged out successfully.\n";
                     pause();
                     break;
+                case 11:
+                    viewNotifications();
+                    pause();
+                    break;
+                case 12:
+                    viewTopPosts();
+                    pause();
+                    break;
+                case 13:
+                    viewTrending();
+                    pause();
+                    break;
+                case 14:
+                    searchAll();
+                    pause();
+                    break;
                 default:
                     std::cout << " Invalid choice.\n";
                     pause();
@@ -489,6 +717,15 @@ int main() {
         // (but recommended to implement it in SystemCore)
     }
 
+    // Follow suggestions for everyone, worked out behind the menu; until
+    // they are ready the Follow menu computes them on demand
+    std::thread suggestions([&core] { core.precomputeRecommendations(); });
+
+    // Fold the mutation log into a fresh snapshot in the background
+    core.startBackgroundCompaction(std::chrono::seconds(30));
+
+    // Let the load messages reach the console before the menu
+    flushLog();
     std::cout << " System ready!\n";
     pause();
 
@@ -496,8 +733,11 @@ int main() {
     mainMenu();
 
     // Save data before exit
+    suggestions.join();
     std::cout << "\n Saving data...\n";
+    core.stopBackgroundCompaction();
     core.saveAllData();
+    flushLog();
     std::cout << " Data saved successfully!\n";
 
     return 0;
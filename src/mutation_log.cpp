@@ -0,0 +1,372 @@
+#include "mutation_log.h"
+#include "utils.h"
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static bool truncateFd(int fd, uint64_t length) {
+#ifdef _WIN32
+    return _chsize_s(fd, static_cast<__int64>(length)) == 0;
+#else
+    return ftruncate(fd, static_cast<off_t>(length)) == 0;
+#endif
+}
+
+// ---------------------- Record Format ----------------------
+std::string Mutation::serialize() const {
+    std::string line;
+    line.reserve(payload.size() + 3);
+    line += static_cast<char>(type);
+    line += '|';
+    line += payload;
+    line += '\n';
+    return line;
+}
+
+Mutation Mutation::deserialize(const std::string& line) {
+    if (line.size() < 2 || line[1] != '|') {
+        throw std::runtime_error("Invalid mutation record");
+    }
+
+    switch (line[0]) {
+        case 'U': case 'P': case 'F': case 'X':
+        case 'L': case 'K': case 'E': case 'R':
+            break;
+        default:
+            throw std::runtime_error("Unknown mutation type");
+    }
+
+    return Mutation{static_cast<MutationType>(line[0]), line.substr(2)};
+}
+
+// ---------------------- Constructor / Destructor ----------------------
+MutationLog::MutationLog(const std::string& logPath)
+    : path(logPath), archivePath(logPath + ".old"), file(nullptr), fileBytes(0),
+      appendedSeq(0), durableSeq(0), failedSeq(0), flushing(false), syncOwed(false), dirSyncOwed(false),
+      policy(FsyncPolicy::EveryCommit), syncInterval(100),
+      lastSync(std::chrono::steady_clock::now()) {}
+
+MutationLog::~MutationLog() {
+    close();
+}
+
+// ---------------------- Open / Close ----------------------
+bool MutationLog::open() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (file) return true;
+
+    if (!trimTornTail(archivePath) || !trimTornTail(path)) {
+        log("ERROR", "Failed to trim torn record from mutation log: " + path);
+        return false;
+    }
+    bool created = !std::ifstream(path, std::ios::binary).is_open();
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        log("ERROR", "Failed to open mutation log: " + path);
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    fileBytes = static_cast<uint64_t>(std::ftell(file));
+    if (created) {
+        dirSyncOwed = true;
+        syncDirectory();
+    }
+    return true;
+}
+
+void MutationLog::close() {
+    // Make sure nothing buffered is lost on shutdown
+    uint64_t seq;
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        seq = appendedSeq;
+    }
+    commit(seq);
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (file) {
+        syncFile();
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool MutationLog::isOpen() const {
+    return file != nullptr;
+}
+
+void MutationLog::setFsyncPolicy(FsyncPolicy p, std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    policy = p;
+    syncInterval = interval;
+}
+
+// ---------------------- Append / Group Commit ----------------------
+uint64_t MutationLog::append(const Mutation& m) {
+    std::string record = m.serialize();
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    pending += record;
+    return ++appendedSeq;
+}
+
+bool MutationLog::commit(uint64_t seq) {
+    std::unique_lock<std::mutex> lock(logMutex);
+
+    while (durableSeq < seq) {
+        if (flushing) {
+            // Another committer is writing; our record may be in its batch
+            flushed.wait(lock);
+            if (durableSeq < seq && failedSeq >= seq) return false;
+            continue;
+        }
+
+        // Become the leader for everything appended so far
+        flushing = true;
+        std::string batch;
+        batch.swap(pending);
+        uint64_t batchSeq = appendedSeq;
+        bool forceSync = syncOwed;
+        lock.unlock();
+
+        bool ok = writeBatch(batch, forceSync);
+
+        lock.lock();
+        if (ok) {
+            durableSeq = batchSeq;
+        } else {
+            failedSeq = batchSeq;
+        }
+        flushing = false;
+        flushed.notify_all();
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Called by the commit leader without logMutex. On a failed write the
+// partial bytes are cut off and the batch goes back to the front of pending.
+bool MutationLog::writeBatch(const std::string& batch, bool forceSync) {
+    if (!file) {
+        if (batch.empty()) return true;
+        std::lock_guard<std::mutex> lock(logMutex);
+        pending.insert(0, batch);
+        log("ERROR", "Mutation log is not open: " + path);
+        return false;
+    }
+
+    if (!batch.empty()) {
+        bool written = std::fwrite(batch.data(), 1, batch.size(), file) == batch.size();
+        if (std::fflush(file) != 0) written = false;
+        if (!written) {
+            std::clearerr(file);
+            truncateFd(fileno(file), fileBytes);
+            std::fseek(file, 0, SEEK_END);
+            std::lock_guard<std::mutex> lock(logMutex);
+            pending.insert(0, batch);
+            log("ERROR", "Failed to write to mutation log: " + path);
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    fileBytes += batch.size();
+    if (batch.empty() && !forceSync) return true;
+
+    auto now = std::chrono::steady_clock::now();
+    bool sync = forceSync || policy == FsyncPolicy::EveryCommit ||
+                (policy == FsyncPolicy::Interval && now - lastSync >= syncInterval);
+    if (!sync) return true;
+
+    if (!syncFile()) {
+        // The bytes are in the file; only the sync has to be retried
+        syncOwed = true;
+        log("ERROR", "Failed to sync mutation log: " + path);
+        return false;
+    }
+    syncOwed = false;
+    lastSync = now;
+    return true;
+}
+
+bool MutationLog::syncFile() {
+    if (!file) return true;
+    if (dirSyncOwed && !syncDirectory()) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// A new segment's directory entry has to be on disk before commits in it
+// count as durable. Tried once when the file is created; if that fails,
+// the next commit's sync retries it (and fails until it succeeds).
+bool MutationLog::syncDirectory() {
+    size_t slash = path.find_last_of('/');
+    if (!fsyncDirectory(slash == std::string::npos ? "." : path.substr(0, slash))) {
+        syncOwed = true;
+        log("ERROR", "Failed to sync the directory of mutation log: " + path);
+        return false;
+    }
+    dirSyncOwed = false;
+    return true;
+}
+
+// Cut a final record that has no '\n' (a write torn by a crash). Replay
+// already skips it, but a record appended after it would be glued on.
+bool MutationLog::trimTornTail(const std::string& filePath) {
+    FILE* f = std::fopen(filePath.c_str(), "rb");
+    if (!f) return true;
+
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    long keep = size;
+    char buf[4096];
+    while (keep > 0) {
+        long chunk = std::min<long>(keep, sizeof(buf));
+        std::fseek(f, keep - chunk, SEEK_SET);
+        if (std::fread(buf, 1, chunk, f) != static_cast<size_t>(chunk)) {
+            std::fclose(f);
+            return false;
+        }
+        long i = chunk;
+        while (i > 0 && buf[i - 1] != '\n') --i;
+        if (i > 0) {
+            keep = keep - chunk + i;
+            break;
+        }
+        keep -= chunk;
+    }
+    std::fclose(f);
+    if (keep == size) return true;
+
+    log("WARNING", "Dropping torn record (" + std::to_string(size - keep) + " bytes) at the end of " + filePath);
+#ifdef _WIN32
+    int fd = _open(filePath.c_str(), _O_RDWR | _O_BINARY);
+#else
+    int fd = ::open(filePath.c_str(), O_RDWR);
+#endif
+    if (fd < 0) return false;
+    bool ok = truncateFd(fd, static_cast<uint64_t>(keep));
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+    return ok;
+}
+
+// ---------------------- Replay ----------------------
+size_t MutationLog::replay(const std::function<void(const Mutation&)>& apply) const {
+    // An archive only survives if the last compaction did not finish
+    return replayFile(archivePath, apply) + replayFile(path, apply);
+}
+
+size_t MutationLog::replayFile(const std::string& filePath, const std::function<void(const Mutation&)>& apply) {
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in.is_open()) return 0;
+
+    size_t applied = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        // A final line without '\n' is a torn write from a crash; ignore it
+        if (in.eof()) break;
+        if (line.empty()) continue;
+        try {
+            apply(Mutation::deserialize(line));
+            applied++;
+        } catch (const std::exception& e) {
+            log("ERROR", "Skipping bad mutation record: " + std::string(e.what()));
+        }
+    }
+    return applied;
+}
+
+// ---------------------- Rotation ----------------------
+bool MutationLog::rotate() {
+    std::unique_lock<std::mutex> lock(logMutex);
+    flushed.wait(lock, [this] { return !flushing; });
+
+    // Anything still buffered belongs to the segment being archived. If it
+    // can't be written or synced, keep the live segment and its records.
+    if (file && !pending.empty()) {
+        bool written = std::fwrite(pending.data(), 1, pending.size(), file) == pending.size();
+        if (std::fflush(file) != 0) written = false;
+        if (!written) {
+            std::clearerr(file);
+            truncateFd(fileno(file), fileBytes);
+            std::fseek(file, 0, SEEK_END);
+            log("ERROR", "Failed to write to mutation log before rotating: " + path);
+            return false;
+        }
+        fileBytes += pending.size();
+    }
+    if (file && !syncFile()) {
+        syncOwed = true;
+        log("ERROR", "Failed to sync mutation log before rotating: " + path);
+        return false;
+    }
+    pending.clear();
+    durableSeq = appendedSeq;
+    syncOwed = false;
+    flushed.notify_all();
+
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    bool ok = true;
+    std::ifstream existing(archivePath, std::ios::binary);
+    std::ifstream liveCheck(path, std::ios::binary);
+    if (!liveCheck.is_open()) {
+        // Nothing has been logged yet
+    } else if (existing.is_open()) {
+        // A previous compaction failed; keep its records and add ours after them
+        existing.close();
+        liveCheck.close();
+        std::ifstream live(path, std::ios::binary);
+        std::ofstream archive(archivePath, std::ios::binary | std::ios::app);
+        if (live.is_open() && archive.is_open() && live.peek() != EOF) {
+            archive << live.rdbuf();
+        }
+        ok = archive.good();
+        archive.close();
+        live.close();
+        if (ok) std::fclose(std::fopen(path.c_str(), "wb"));
+    } else {
+        liveCheck.close();
+        ok = std::rename(path.c_str(), archivePath.c_str()) == 0;
+    }
+
+    file = std::fopen(path.c_str(), "ab");
+    if (file) {
+        std::fseek(file, 0, SEEK_END);
+        fileBytes = static_cast<uint64_t>(std::ftell(file));
+        // The rename (or a first create) changed the directory
+        dirSyncOwed = true;
+        syncDirectory();
+    }
+    if (!ok || !file) {
+        log("ERROR", "Failed to rotate mutation log: " + path);
+        return false;
+    }
+    return true;
+}
+
+void MutationLog::dropArchive() {
+    std::remove(archivePath.c_str());
+}
+
+uint64_t MutationLog::sizeBytes() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return fileBytes + pending.size();
+}
@@ -0,0 +1,133 @@
+#include "notification_dispatcher.h"
+#include "utils.h"
+#include <unordered_map>
+#include <algorithm>
+#include <exception>
+
+// ---------------------- Constructor / Destructor ----------------------
+NotificationDispatcher::NotificationDispatcher(size_t workerCount, size_t queueCapacity)
+    : capacity(queueCapacity), inFlight(0), stopping(false), totalLatencyMs(0.0) {
+    workerCount = std::max<size_t>(1, workerCount);
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&NotificationDispatcher::workerLoop, this);
+    }
+}
+
+// Queued notifications are still delivered before the workers exit
+NotificationDispatcher::~NotificationDispatcher() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    eventReady.notify_all();
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+// ---------------------- Queue ----------------------
+bool NotificationDispatcher::enqueue(std::shared_ptr<PostNotifier> notifier, std::shared_ptr<const Post> post) {
+    if (!notifier || !post || !notifier->hasObservers()) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.size() >= capacity) {
+            stats.dropped++;
+            return false;
+        }
+        queue.push_back(Event{std::move(notifier), std::move(post), std::chrono::steady_clock::now()});
+        stats.enqueued++;
+        stats.maxQueueDepth = std::max(stats.maxQueueDepth, queue.size());
+    }
+    eventReady.notify_one();
+    return true;
+}
+
+void NotificationDispatcher::drain() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    idle.wait(lock, [this] { return queue.empty() && inFlight == 0; });
+}
+
+void NotificationDispatcher::quiesce() {
+    std::unique_lock<std::shared_mutex> lock(deliveryMutex);
+}
+
+NotificationStats NotificationDispatcher::getStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    NotificationStats result = stats;
+    result.queueDepth = queue.size();
+    if (stats.delivered > 0) {
+        result.avgLatencyMs = totalLatencyMs / static_cast<double>(stats.delivered);
+    }
+    return result;
+}
+
+// ---------------------- Workers ----------------------
+void NotificationDispatcher::workerLoop() {
+    std::vector<Event> batch;
+    batch.reserve(BATCH_SIZE);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            eventReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;     // stopping, and nothing left to deliver
+
+            size_t take = std::min(queue.size(), BATCH_SIZE);
+            for (size_t i = 0; i < take; ++i) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+            inFlight += take;
+        }
+
+        deliver(batch);
+
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (const Event& e : batch) {
+                double ms = std::chrono::duration<double, std::milli>(now - e.enqueued).count();
+                totalLatencyMs += ms;
+                stats.maxLatencyMs = std::max(stats.maxLatencyMs, ms);
+            }
+            stats.delivered += batch.size();
+            stats.batches++;
+            inFlight -= batch.size();
+            if (queue.empty() && inFlight == 0) idle.notify_all();
+        }
+        batch.clear();
+    }
+}
+
+// Coalesce the batch by observer, keeping queue order for each one
+void NotificationDispatcher::deliver(std::vector<Event>& batch) {
+    std::shared_lock<std::shared_mutex> deliveryLock(deliveryMutex);
+
+    std::unordered_map<const PostNotifier*, std::shared_ptr<const PostNotifier::ObserverList>> lists;
+    std::unordered_map<IObserver*, size_t> slotOf;
+    std::vector<std::pair<IObserver*, std::vector<const Post*>>> pending;
+
+    for (const Event& e : batch) {
+        auto& list = lists[e.notifier.get()];
+        if (!list) list = e.notifier->snapshot();
+        for (IObserver* observer : *list) {
+            auto slot = slotOf.emplace(observer, pending.size());
+            if (slot.second) pending.emplace_back(observer, std::vector<const Post*>());
+            pending[slot.first->second].second.push_back(e.post.get());
+        }
+    }
+
+    for (auto& entry : pending) {
+        try {
+            entry.first->onNotifyNewPosts(entry.second);
+        } catch (const std::exception& ex) {
+            log("ERROR", "Observer failed: " + std::string(ex.what()));
+        } catch (...) {
+            log("ERROR", "Observer failed");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stats.observerCalls += pending.size();
+}
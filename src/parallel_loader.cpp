@@ -0,0 +1,42 @@
+#include "parallel_loader.h"
+#include <fstream>
+#include <algorithm>
+
+bool readWholeFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+
+    std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<size_t>(size > 0 ? size : 0));
+    if (size > 0) {
+        in.read(&out[0], size);
+    }
+    return true;
+}
+
+std::vector<std::string_view> splitChunks(std::string_view buffer, size_t targetChunks) {
+    // Below this a chunk costs more to schedule than to parse
+    const size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+    std::vector<std::string_view> chunks;
+    if (buffer.empty()) return chunks;
+
+    if (targetChunks == 0) targetChunks = 1;
+    size_t chunkBytes = std::max(MIN_CHUNK_BYTES, buffer.size() / targetChunks + 1);
+
+    size_t start = 0;
+    while (start < buffer.size()) {
+        size_t end = start + chunkBytes;
+        if (end >= buffer.size()) {
+            end = buffer.size();
+        } else {
+            // Extend to the end of the line so no record is split
+            size_t nl = buffer.find('\n', end);
+            end = (nl == std::string_view::npos) ? buffer.size() : nl + 1;
+        }
+        chunks.push_back(buffer.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
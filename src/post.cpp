@@ -1,58 +1,130 @@
 #include "../include/Post.h"
 #include "../include/Utils.h"
+#include "../include/field_parser.h"
+#include "../include/string_arena.h"
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
 
 // Constructors
-Post::Post() : postID(""), userID(""), content(""), timestamp(0), likes(0) {}
+Post::Post()
+    : idx(INVALID_IDX), authorIdx(INVALID_IDX), content(), timestamp(0), likeSlot(nullptr), likes(0) {}
 
 Post::Post(const std::string& pID, const std::string& uID, const std::string& cont, uint64_t ts)
-    : postID(pID), userID(uID), content(cont), timestamp(ts), likes(0) {}
+    : idx(postIdTable().intern(pID)), authorIdx(userIdTable().intern(uID)),
+      content(textArena().store(cont)), timestamp(ts), likeSlot(nullptr), likes(0) {}
+
+// Copies of a stored post read the same column slot
+Post::Post(const Post& other)
+    : idx(other.idx), authorIdx(other.authorIdx), content(other.content),
+      timestamp(other.timestamp), likeSlot(other.likeSlot), likes(other.likes) {}
+
+Post::Post(Post&& other) noexcept
+    : idx(other.idx), authorIdx(other.authorIdx), content(other.content),
+      timestamp(other.timestamp), likeSlot(other.likeSlot), likes(other.likes) {}
+
+Post& Post::operator=(const Post& other) {
+    idx = other.idx;
+    authorIdx = other.authorIdx;
+    content = other.content;
+    timestamp = other.timestamp;
+    likeSlot = other.likeSlot;
+    likes = other.likes;
+    return *this;
+}
+
+Post& Post::operator=(Post&& other) noexcept {
+    idx = other.idx;
+    authorIdx = other.authorIdx;
+    content = other.content;
+    timestamp = other.timestamp;
+    likeSlot = other.likeSlot;
+    likes = other.likes;
+    return *this;
+}
 
 // Getters
-std::string Post::getPostID() const { return postID; }
-std::string Post::getUserID() const { return userID; }
-std::string Post::getContent() const { return content; }
+const std::string& Post::getPostID() const { return postIdTable().name(idx); }
+const std::string& Post::getUserID() const { return userIdTable().name(authorIdx); }
+PostIdx Post::getIdx() const { return idx; }
+UserIdx Post::getAuthorIdx() const { return authorIdx; }
+std::string_view Post::getContent() const { return content; }
 uint64_t Post::getTimestamp() const { return timestamp; }
-int Post::getLikes() const { return likes; }
+int Post::getLikes() const {
+    return likeSlot ? likeSlot->load(std::memory_order_relaxed) : likes;
+}
 
 // Actions
 void Post::like() {
-    likes++;
+    if (likeSlot) {
+        likeSlot->fetch_add(1, std::memory_order_relaxed);
+    } else {
+        likes++;
+    }
+}
+
+void Post::setLikes(int count) {
+    if (likeSlot) {
+        likeSlot->store(count, std::memory_order_relaxed);
+    } else {
+        likes = count;
+    }
 }
 
 void Post::editContent(const std::string& newContent) {
     if (!newContent.empty()) {
-        content = newContent;
+        content = textArena().store(newContent);
     }
 }
 
-// Serialization: postID|userID|timestamp|likes|content_encoded
+// Serialization: postID|userID|timestamp|likes|content_encoded[|liker1,liker2]
+// The liker list is only written when there is one
 std::string Post::serialize() const {
+    return serialize(getLikes(), IdView());
+}
+
+std::string Post::serialize(int likeCount, IdView likedBy) const {
     std::ostringstream oss;
-    oss << postID << "|" << userID << "|" << timestamp << "|" << likes << "|" << urlEncode(content);
+    oss << getPostID() << "|" << getUserID() << "|" << timestamp << "|" << likeCount << "|" << urlEncode(content);
+    if (!likedBy.empty()) {
+        std::string likers;
+        appendUserIDList(likers, likedBy);
+        oss << "|" << likers;
+    }
     return oss.str();
 }
 
-Post Post::deserialize(const std::string& line) {
-    std::vector<std::string> parts = safeSplit(line, '|');
+Post Post::deserialize(std::string_view line, std::vector<UserIdx>* likedBy) {
+    std::string_view parts[6];
+    size_t count = splitFields(line, '|', parts, 6);
     
-    if (parts.size() < 5) {
+    if (count < 5) {
         throw std::runtime_error("Invalid post data format");
     }
     
-    Post p(parts[0], parts[1], urlDecode(parts[4]), std::stoull(parts[2]));
-    p.likes = std::stoi(parts[3]);
+    // Fields are decoded straight into the members, no temporaries
+    Post p;
+    int likeCount;
+    if (!parseUint64(parts[2], p.timestamp) || !parseInt(parts[3], likeCount)) {
+        throw std::runtime_error("Invalid post timestamp or likes");
+    }
+    p.setLikes(likeCount);
+    p.idx = postIdTable().intern(parts[0]);
+    p.authorIdx = userIdTable().intern(parts[1]);
+    p.content = textArena().storeDecoded(parts[4]);
+
+    if (likedBy && count > 5 && !parts[5].empty()) {
+        splitUserIDList(parts[5], *likedBy);
+    }
     
     return p;
 }
 
 void Post::display() const {
-    std::cout << "\n[@" << userID << "] - " << formatTimestamp(timestamp) << "\n";
+    std::cout << "\n[@" << getUserID() << "] - " << formatTimestamp(timestamp) << "\n";
     std::cout << content << "\n";
-    std::cout << "❤️  " << likes << " likes\n";
+    std::cout << "❤️  " << getLikes() << " likes\n";
 }
 
 bool Post::operator<(const Post& other) const {
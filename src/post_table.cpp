@@ -0,0 +1,154 @@
+#include "post_table.h"
+#include <algorithm>
+
+PostTable::PostTable() : count(0) {}
+
+void PostTable::reserve(size_t slots) {
+    timestamps.reserve(slots);
+    authors.reserve(slots);
+    contents.reserve(slots);
+    present.reserve(slots);
+}
+
+// New like chunks start zeroed
+void PostTable::grow(size_t slots) {
+    timestamps.resize(slots, 0);
+    authors.resize(slots, INVALID_IDX);
+    contents.resize(slots);
+    present.resize(slots, 0);
+    while (likeChunks.size() * LIKE_CHUNK < slots) {
+        likeChunks.emplace_back(new std::atomic<int32_t>[LIKE_CHUNK]());
+    }
+}
+
+void PostTable::store(Post& p) {
+    PostIdx idx = p.getIdx();
+    if (idx >= present.size()) grow(idx + 1);
+    if (!present[idx]) count++;
+
+    timestamps[idx] = p.timestamp;
+    authors[idx] = p.authorIdx;
+    contents[idx] = p.content;
+    present[idx] = 1;
+    if (p.likeSlot != &likeSlot(idx)) {
+        setLikes(idx, p.getLikes());
+        p.likeSlot = &likeSlot(idx);
+    }
+}
+
+// ---------------------- Scans ----------------------
+// Orderings as "a comes before b", reading the columns only
+namespace {
+struct NewestFirst {
+    const uint64_t* timestamps;
+    bool operator()(PostIdx a, PostIdx b) const {
+        return olderThan(FeedKey{timestamps[b], b}, FeedKey{timestamps[a], a});
+    }
+};
+
+struct MostLikedFirst {
+    const PostTable* table;
+    bool operator()(PostIdx a, PostIdx b) const {
+        int la = table->likes(a), lb = table->likes(b);
+        if (la != lb) return la > lb;
+        return olderThan(table->key(b), table->key(a));
+    }
+};
+}
+
+// The keys are copied out next to their handles first, so the sort moves
+// 16-byte entries and never goes back to the columns. Newest leaves every
+// like count at zero and falls through to the timestamp. Counts are signed,
+// so a negative one (from an old L record) sorts last, as in top().
+void PostTable::sort(std::vector<PostIdx>& handles, PostOrder order, size_t limit) const {
+    struct Entry {
+        uint64_t timestamp;
+        int32_t likes;
+        PostIdx idx;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(handles.size());
+    for (PostIdx idx : handles) {
+        int32_t likeKey = (order == PostOrder::MostLiked) ? likes(idx) : 0;
+        entries.push_back(Entry{timestamps[idx], likeKey, idx});
+    }
+    auto first = [](const Entry& a, const Entry& b) {
+        if (a.likes != b.likes) return a.likes > b.likes;
+        if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+        return a.idx > b.idx;
+    };
+    // partial_sort is a heap sort; over every entry std::sort is several times faster
+    limit = std::min(limit, entries.size());
+    if (limit < entries.size()) {
+        std::partial_sort(entries.begin(), entries.begin() + limit, entries.end(), first);
+    } else {
+        std::sort(entries.begin(), entries.end(), first);
+    }
+    handles.resize(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        handles[i] = entries[i].idx;
+    }
+}
+
+// The heap's front is the weakest of the current top k, so most posts
+// cost one comparison against it and are skipped
+template <typename Before>
+static void topK(const std::vector<uint8_t>& present, size_t k, Before before,
+                 std::vector<PostIdx>& out) {
+    out.clear();
+    if (k == 0) return;
+    out.reserve(std::min(k, present.size()));
+
+    for (PostIdx idx = 0; idx < present.size(); ++idx) {
+        if (!present[idx]) continue;
+        if (out.size() < k) {
+            out.push_back(idx);
+            std::push_heap(out.begin(), out.end(), before);
+        } else if (before(idx, out.front())) {
+            std::pop_heap(out.begin(), out.end(), before);
+            out.back() = idx;
+            std::push_heap(out.begin(), out.end(), before);
+        }
+    }
+    std::sort_heap(out.begin(), out.end(), before);
+}
+
+void PostTable::top(size_t k, PostOrder order, std::vector<PostIdx>& out) const {
+    if (order == PostOrder::Newest) {
+        topK(present, k, NewestFirst{timestamps.data()}, out);
+    } else {
+        topK(present, k, MostLikedFirst{this}, out);
+    }
+}
+
+uint64_t PostTable::totalLikes() const {
+    uint64_t total = 0;
+    for (size_t c = 0; c < likeChunks.size(); ++c) {
+        size_t n = std::min(LIKE_CHUNK, present.size() - c * LIKE_CHUNK);
+        const std::atomic<int32_t>* chunk = likeChunks[c].get();
+        for (size_t i = 0; i < n; ++i) {
+            total += chunk[i].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+// Like chunks stay allocated: records handed out earlier point into them
+void PostTable::clear() {
+    timestamps.clear();
+    authors.clear();
+    contents.clear();
+    present.clear();
+    for (const auto& chunk : likeChunks) {
+        for (size_t i = 0; i < LIKE_CHUNK; ++i) chunk[i].store(0, std::memory_order_relaxed);
+    }
+    count = 0;
+}
+
+size_t PostTable::memoryBytes() const {
+    return timestamps.capacity() * sizeof(uint64_t) +
+           authors.capacity() * sizeof(UserIdx) +
+           contents.capacity() * sizeof(std::string_view) +
+           present.capacity() * sizeof(uint8_t) +
+           likeChunks.size() * LIKE_CHUNK * sizeof(std::atomic<int32_t>);
+}
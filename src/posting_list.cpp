@@ -0,0 +1,67 @@
+#include "posting_list.h"
+#include <algorithm>
+
+// Gap from the previous member (from 0 for the first), seven bits per byte,
+// high bit set on every byte but the last
+void PostingList::append(uint32_t id) {
+    uint32_t gap = (count == 0) ? id : id - last;
+    while (gap >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(gap | 0x80));
+        gap >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(gap));
+    last = id;
+    count++;
+}
+
+void PostingList::assign(const std::vector<uint32_t>& ids) {
+    bytes.clear();
+    count = 0;
+    last = 0;
+    bytes.reserve(ids.size() + ids.size() / 4);
+    for (uint32_t id : ids) append(id);
+}
+
+bool PostingList::add(uint32_t id) {
+    if (count == 0 || id > last) {
+        append(id);
+        return true;
+    }
+    std::vector<uint32_t> ids;
+    decode(ids);
+    auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos != ids.end() && *pos == id) return false;
+    ids.insert(pos, id);
+    assign(ids);
+    return true;
+}
+
+bool PostingList::remove(uint32_t id) {
+    if (count == 0 || id > last) return false;
+    std::vector<uint32_t> ids;
+    decode(ids);
+    auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos == ids.end() || *pos != id) return false;
+    ids.erase(pos);
+    assign(ids);
+    return true;
+}
+
+void PostingList::decode(std::vector<uint32_t>& out) const {
+    out.clear();
+    out.reserve(count);
+    uint32_t value = 0;
+    size_t i = 0;
+    while (i < bytes.size()) {
+        uint32_t gap = 0;
+        int shift = 0;
+        uint8_t b;
+        do {
+            b = bytes[i++];
+            gap |= static_cast<uint32_t>(b & 0x7f) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        value += gap;
+        out.push_back(value);
+    }
+}
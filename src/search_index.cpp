@@ -0,0 +1,247 @@
+#include "search_index.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+// ---------------------- Tokenizing ----------------------
+static bool isWordByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_' || c >= 0x80;
+}
+
+static char lowerByte(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string SearchIndex::lowerCase(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) c = lowerByte(c);
+    return out;
+}
+
+void SearchIndex::tokenize(std::string_view text, std::vector<std::string>& terms) {
+    terms.clear();
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && !isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        size_t start = i;
+        while (i < text.size() && isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        if (i == start) continue;
+
+        std::string term = lowerCase(text.substr(start, std::min(i - start, MAX_TERM_LENGTH)));
+        if (std::find(terms.begin(), terms.end(), term) == terms.end()) terms.push_back(std::move(term));
+    }
+}
+
+void SearchIndex::userTermsOf(const UserText& text, std::vector<std::string>& terms) {
+    std::vector<std::string> part;
+    tokenize(text.username, terms);
+    for (std::string_view field : {text.name, text.bio}) {
+        tokenize(field, part);
+        for (std::string& term : part) {
+            if (std::find(terms.begin(), terms.end(), term) == terms.end()) terms.push_back(std::move(term));
+        }
+    }
+}
+
+// ---------------------- Updates ----------------------
+void SearchIndex::addTerms(TermMap& map, const std::vector<std::string>& terms, uint32_t id) {
+    for (const std::string& term : terms) map[term].add(id);
+}
+
+void SearchIndex::removeTerms(TermMap& map, const std::vector<std::string>& terms, uint32_t id) {
+    for (const std::string& term : terms) {
+        auto it = map.find(term);
+        if (it == map.end()) continue;
+        it->second.remove(id);
+        if (it->second.empty()) map.erase(it);
+    }
+}
+
+// Terms of a that are not in b
+static std::vector<std::string> missingFrom(const std::vector<std::string>& a, const std::vector<std::string>& b) {
+    std::vector<std::string> out;
+    for (const std::string& term : a) {
+        if (std::find(b.begin(), b.end(), term) == b.end()) out.push_back(term);
+    }
+    return out;
+}
+
+void SearchIndex::addPost(PostIdx post, std::string_view content) {
+    std::vector<std::string> terms;
+    tokenize(content, terms);
+    addTerms(postTerms, terms, post);
+}
+
+// Only the words that changed touch their lists
+void SearchIndex::updatePost(PostIdx post, std::string_view oldContent, std::string_view newContent) {
+    std::vector<std::string> before, after;
+    tokenize(oldContent, before);
+    tokenize(newContent, after);
+    removeTerms(postTerms, missingFrom(before, after), post);
+    addTerms(postTerms, missingFrom(after, before), post);
+}
+
+void SearchIndex::addUser(UserIdx user, const UserText& text) {
+    std::vector<std::string> terms;
+    userTermsOf(text, terms);
+    addTerms(userTerms, terms, user);
+    usernames.emplace(lowerCase(text.username), user);
+}
+
+void SearchIndex::updateUser(UserIdx user, const UserText& oldText, const UserText& newText) {
+    std::vector<std::string> before, after;
+    userTermsOf(oldText, before);
+    userTermsOf(newText, after);
+    removeTerms(userTerms, missingFrom(before, after), user);
+    addTerms(userTerms, missingFrom(after, before), user);
+    if (oldText.username != newText.username) {
+        usernames.erase(std::make_pair(lowerCase(oldText.username), user));
+        usernames.emplace(lowerCase(newText.username), user);
+    }
+}
+
+// ---------------------- Queries ----------------------
+// AND starts from the shortest list so the running result only shrinks
+void SearchIndex::find(const TermMap& map, const std::vector<std::string>& terms,
+                       SearchMode mode, std::vector<uint32_t>& out) {
+    out.clear();
+    std::vector<const PostingList*> lists;
+    for (const std::string& term : terms) {
+        auto it = map.find(term);
+        if (it != map.end()) {
+            lists.push_back(&it->second);
+        } else if (mode == SearchMode::All) {
+            return;
+        }
+    }
+    if (lists.empty()) return;
+
+    std::vector<uint32_t> ids, merged;
+    if (mode == SearchMode::All) {
+        std::sort(lists.begin(), lists.end(),
+                  [](const PostingList* a, const PostingList* b) { return a->size() < b->size(); });
+        lists[0]->decode(out);
+        for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+            lists[i]->decode(ids);
+            merged.clear();
+            std::set_intersection(out.begin(), out.end(), ids.begin(), ids.end(), std::back_inserter(merged));
+            out.swap(merged);
+        }
+    } else {
+        for (const PostingList* list : lists) {
+            list->decode(ids);
+            merged.clear();
+            merged.reserve(out.size() + ids.size());
+            std::set_union(out.begin(), out.end(), ids.begin(), ids.end(), std::back_inserter(merged));
+            out.swap(merged);
+        }
+    }
+}
+
+void SearchIndex::findPosts(const std::vector<std::string>& terms, SearchMode mode, std::vector<PostIdx>& out) const {
+    find(postTerms, terms, mode, out);
+}
+
+void SearchIndex::findUsers(const std::vector<std::string>& terms, SearchMode mode, std::vector<UserIdx>& out) const {
+    find(userTerms, terms, mode, out);
+}
+
+void SearchIndex::usernamesWithPrefix(std::string_view prefix, size_t limit, std::vector<UserIdx>& out) const {
+    out.clear();
+    std::string lower = lowerCase(prefix);
+    for (auto it = usernames.lower_bound(std::make_pair(lower, UserIdx(0)));
+         it != usernames.end() && out.size() < limit; ++it) {
+        if (it->first.compare(0, lower.size(), lower) != 0) break;
+        out.push_back(it->second);
+    }
+}
+
+// ---------------------- Bulk Build ----------------------
+// Two passes on the pool: each chunk of documents collects its own
+// term -> ids lists, then each partition of the term space merges, sorts
+// and encodes its terms from every chunk. No lock is taken in either pass.
+template<typename Doc, typename TermsFn>
+static void buildTerms(ThreadPool& pool, std::unordered_map<std::string, PostingList>& map,
+                       const std::vector<Doc>& docs, TermsFn termsOf) {
+    using Lists = std::unordered_map<std::string, std::vector<uint32_t>>;
+    const size_t parts = pool.size() * 4;
+    const size_t chunkSize = (docs.size() + parts - 1) / parts;
+
+    // chunks[c][p]: chunk c's lists for the terms of partition p
+    std::vector<std::vector<Lists>> chunks(parts, std::vector<Lists>(parts));
+    parallelFor(pool, parts, [&](size_t c) {
+        std::hash<std::string> hasher;
+        std::vector<std::string> terms;
+        size_t end = std::min(docs.size(), (c + 1) * chunkSize);
+        for (size_t i = c * chunkSize; i < end; ++i) {
+            uint32_t id = termsOf(docs[i], terms);
+            for (std::string& term : terms) {
+                Lists& lists = chunks[c][hasher(term) % parts];
+                lists[std::move(term)].push_back(id);
+            }
+        }
+    });
+
+    std::vector<std::unordered_map<std::string, PostingList>> partitions(parts);
+    parallelFor(pool, parts, [&](size_t p) {
+        Lists merged;
+        for (const std::vector<Lists>& chunk : chunks) {
+            for (const auto& entry : chunk[p]) {
+                std::vector<uint32_t>& ids = merged[entry.first];
+                ids.insert(ids.end(), entry.second.begin(), entry.second.end());
+            }
+        }
+        for (auto& entry : merged) {
+            std::vector<uint32_t>& ids = entry.second;
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            partitions[p][entry.first].assign(ids);
+        }
+    });
+
+    map.clear();
+    for (auto& partition : partitions) {
+        for (auto& entry : partition) map.emplace(entry.first, std::move(entry.second));
+    }
+}
+
+void SearchIndex::build(ThreadPool& pool,
+                        const std::vector<std::pair<PostIdx, std::string_view>>& posts,
+                        const std::vector<std::pair<UserIdx, UserText>>& users) {
+    buildTerms(pool, postTerms, posts,
+        [](const std::pair<PostIdx, std::string_view>& doc, std::vector<std::string>& terms) {
+            tokenize(doc.second, terms);
+            return doc.first;
+        });
+    buildTerms(pool, userTerms, users,
+        [](const std::pair<UserIdx, UserText>& doc, std::vector<std::string>& terms) {
+            userTermsOf(doc.second, terms);
+            return doc.first;
+        });
+
+    usernames.clear();
+    for (const auto& user : users) {
+        usernames.emplace(lowerCase(user.second.username), user.first);
+    }
+}
+
+void SearchIndex::clear() {
+    postTerms.clear();
+    userTerms.clear();
+    usernames.clear();
+}
+
+SearchStats SearchIndex::stats() const {
+    SearchStats s;
+    s.postTerms = postTerms.size();
+    s.userTerms = userTerms.size();
+    for (const TermMap* map : {&postTerms, &userTerms}) {
+        for (const auto& entry : *map) {
+            s.postings += entry.second.size();
+            s.listBytes += entry.second.memoryBytes();
+            s.rawListBytes += entry.second.size() * sizeof(uint32_t);
+        }
+    }
+    return s;
+}
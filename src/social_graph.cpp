@@ -0,0 +1,396 @@
+#include "social_graph.h"
+#include <algorithm>
+
+// ---------------------- Varint Coding ----------------------
+static inline void writeVarint(std::vector<uint8_t>& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+static inline uint32_t readVarint(const uint8_t*& p) {
+    uint32_t value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= static_cast<uint32_t>(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint32_t>(*p++) << shift;
+    return value;
+}
+
+// ---------------------- CSR Arrays ----------------------
+// Resume after the last skip point below v, then decode at most one run
+bool SocialGraph::Csr::contains(UserIdx u, UserIdx v) const {
+    if (u >= degrees.size()) return false;
+    const uint8_t* list = bytes.data() + offsets[u];
+    const SkipEntry* first = skips.data() + skipStart[u];
+    const SkipEntry* last = skips.data() + skipStart[u + 1];
+    const SkipEntry* next = std::lower_bound(first, last, v,
+        [](const SkipEntry& e, UserIdx target) { return e.last < target; });
+
+    const uint8_t* p = list;
+    UserIdx current = 0;
+    uint32_t remaining = degrees[u];
+    if (next != first) {
+        const SkipEntry& from = next[-1];
+        p = list + from.byte;
+        current = from.last;
+        remaining -= static_cast<uint32_t>(next - first) * SKIP_INTERVAL;
+    }
+    for (; remaining > 0; --remaining) {
+        current += readVarint(p);
+        if (current >= v) return current == v;
+    }
+    return false;
+}
+
+void SocialGraph::Csr::decode(UserIdx u, std::vector<UserIdx>& out) const {
+    if (u >= degrees.size()) return;
+    const uint8_t* p = bytes.data() + offsets[u];
+    UserIdx current = 0;
+    out.reserve(out.size() + degrees[u]);
+    for (uint32_t i = 0; i < degrees[u]; ++i) {
+        current += readVarint(p);
+        out.push_back(current);
+    }
+}
+
+size_t SocialGraph::Csr::memoryBytes() const {
+    return offsets.capacity() * sizeof(uint64_t) +
+           degrees.capacity() * sizeof(uint32_t) +
+           bytes.capacity() +
+           skipStart.capacity() * sizeof(uint32_t) +
+           skips.capacity() * sizeof(SkipEntry);
+}
+
+void SocialGraph::Csr::reset(size_t vertexCount, size_t reserveBytes) {
+    offsets.assign(vertexCount + 1, 0);
+    degrees.assign(vertexCount, 0);
+    skipStart.assign(vertexCount + 1, 0);
+    bytes.clear();
+    bytes.reserve(reserveBytes);
+    skips.clear();
+}
+
+// Sorted, duplicate-free list: first index, then gaps
+void SocialGraph::Csr::appendList(UserIdx u, const UserIdx* ids, size_t count) {
+    offsets[u] = bytes.size();
+    skipStart[u] = static_cast<uint32_t>(skips.size());
+    degrees[u] = static_cast<uint32_t>(count);
+    UserIdx prev = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0 && i % SKIP_INTERVAL == 0) {
+            skips.push_back(SkipEntry{prev, static_cast<uint32_t>(bytes.size() - offsets[u])});
+        }
+        writeVarint(bytes, ids[i] - prev);
+        prev = ids[i];
+    }
+}
+
+// Skip offsets are relative to the list, so both copy unchanged
+void SocialGraph::Csr::copyList(UserIdx u, const Csr& from) {
+    offsets[u] = bytes.size();
+    skipStart[u] = static_cast<uint32_t>(skips.size());
+    if (u >= from.vertexCount()) return;
+    degrees[u] = from.degrees[u];
+    bytes.insert(bytes.end(), from.bytes.begin() + from.offsets[u], from.bytes.begin() + from.offsets[u + 1]);
+    skips.insert(skips.end(), from.skips.begin() + from.skipStart[u], from.skips.begin() + from.skipStart[u + 1]);
+}
+
+void SocialGraph::Csr::finish() {
+    offsets.back() = bytes.size();
+    skipStart.back() = static_cast<uint32_t>(skips.size());
+    bytes.shrink_to_fit();
+    skips.shrink_to_fit();
+}
+
+// Bucket the pairs by source vertex (counting sort), then sort and
+// de-duplicate each list on its own. reverse builds the follower direction.
+std::shared_ptr<const SocialGraph::Csr> SocialGraph::buildCsr(size_t vertexCount,
+                                                              const std::vector<std::pair<UserIdx, UserIdx>>& pairs,
+                                                              bool reverse) {
+    std::vector<uint64_t> start(vertexCount + 1, 0);
+    for (const auto& e : pairs) {
+        start[(reverse ? e.second : e.first) + 1]++;
+    }
+    for (size_t u = 0; u < vertexCount; ++u) {
+        start[u + 1] += start[u];
+    }
+
+    std::vector<UserIdx> targets(pairs.size());
+    std::vector<uint64_t> fill(start.begin(), start.end() - 1);
+    for (const auto& e : pairs) {
+        UserIdx from = reverse ? e.second : e.first;
+        targets[fill[from]++] = reverse ? e.first : e.second;
+    }
+
+    auto csr = std::make_shared<Csr>();
+    csr->reset(vertexCount, pairs.size() * 2);
+    for (size_t u = 0; u < vertexCount; ++u) {
+        UserIdx* first = targets.data() + start[u];
+        UserIdx* last = targets.data() + start[u + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        csr->appendList(static_cast<UserIdx>(u), first, static_cast<size_t>(last - first));
+    }
+    csr->finish();
+    return csr;
+}
+
+// ---------------------- One Direction ----------------------
+// Invariants: added never overlaps the CSR list, removed is a subset of it
+bool SocialGraph::Direction::contains(UserIdx u, UserIdx v) const {
+    auto addIt = added.find(u);
+    if (addIt != added.end() && addIt->second.contains(v)) return true;
+    auto remIt = removed.find(u);
+    if (remIt != removed.end() && remIt->second.contains(v)) return false;
+    return csr->contains(u, v);
+}
+
+size_t SocialGraph::Direction::count(UserIdx u) const {
+    size_t n = csr->degree(u);
+    auto addIt = added.find(u);
+    if (addIt != added.end()) n += addIt->second.size();
+    auto remIt = removed.find(u);
+    if (remIt != removed.end()) n -= remIt->second.size();
+    return n;
+}
+
+void SocialGraph::Direction::list(UserIdx u, std::vector<UserIdx>& out) const {
+    out.clear();
+    csr->decode(u, out);
+
+    auto remIt = removed.find(u);
+    if (remIt != removed.end()) {
+        const AdjacencySet& gone = remIt->second;
+        out.erase(std::remove_if(out.begin(), out.end(),
+                                 [&gone](UserIdx v) { return gone.contains(v); }),
+                  out.end());
+    }
+    auto addIt = added.find(u);
+    if (addIt != added.end()) {
+        IdView extra = addIt->second.view();
+        out.insert(out.end(), extra.begin(), extra.end());
+        std::sort(out.begin(), out.end());
+    }
+}
+
+void SocialGraph::Direction::add(UserIdx u, UserIdx v) {
+    auto remIt = removed.find(u);
+    if (remIt != removed.end() && remIt->second.erase(v)) {
+        if (remIt->second.empty()) removed.erase(remIt);
+        return;
+    }
+    added[u].insert(v);
+}
+
+void SocialGraph::Direction::remove(UserIdx u, UserIdx v) {
+    auto addIt = added.find(u);
+    if (addIt != added.end() && addIt->second.erase(v)) {
+        if (addIt->second.empty()) added.erase(addIt);
+        return;
+    }
+    removed[u].insert(v);
+}
+
+// New arrays with the pending edits applied. Untouched lists are copied
+// byte for byte; edited ones are re-encoded and listed in touched.
+std::shared_ptr<const SocialGraph::Csr> SocialGraph::Direction::merged(std::vector<UserIdx>& touched) const {
+    touched.clear();
+    if (added.empty() && removed.empty()) return csr;
+
+    size_t vertexCount = csr->vertexCount();
+    for (const auto& entry : added) {
+        vertexCount = std::max(vertexCount, static_cast<size_t>(entry.first) + 1);
+    }
+
+    auto next = std::make_shared<Csr>();
+    next->reset(vertexCount, csr->bytes.size());
+    std::vector<UserIdx> scratch;
+    for (UserIdx u = 0; u < vertexCount; ++u) {
+        if (added.count(u) == 0 && removed.count(u) == 0) {
+            next->copyList(u, *csr);
+            continue;
+        }
+        list(u, scratch);
+        next->appendList(u, scratch.data(), scratch.size());
+        touched.push_back(u);
+    }
+    next->finish();
+    return next;
+}
+
+// Switch to next, built from an earlier copy of this direction whose edits
+// changed the touched lists. Every list changed then or since is compared
+// with its new encoding, and the differences become the new deltas.
+void SocialGraph::Direction::rebase(std::shared_ptr<const Csr> next, const std::vector<UserIdx>& touched) {
+    std::vector<UserIdx> lists(touched);
+    for (const auto& entry : added) lists.push_back(entry.first);
+    for (const auto& entry : removed) lists.push_back(entry.first);
+    std::sort(lists.begin(), lists.end());
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    std::unordered_map<UserIdx, AdjacencySet> nextAdded, nextRemoved;
+    std::vector<UserIdx> current, base;
+    for (UserIdx u : lists) {
+        list(u, current);
+        base.clear();
+        next->decode(u, base);
+        size_t i = 0, j = 0;
+        while (i < current.size() || j < base.size()) {
+            if (j == base.size() || (i < current.size() && current[i] < base[j])) {
+                nextAdded[u].insert(current[i++]);
+            } else if (i == current.size() || base[j] < current[i]) {
+                nextRemoved[u].insert(base[j++]);
+            } else {
+                ++i;
+                ++j;
+            }
+        }
+    }
+    csr = std::move(next);
+    added.swap(nextAdded);
+    removed.swap(nextRemoved);
+}
+
+size_t SocialGraph::Direction::deltaEdits() const {
+    size_t total = 0;
+    for (const auto* edits : {&added, &removed}) {
+        for (const auto& entry : *edits) total += entry.second.size();
+    }
+    return total;
+}
+
+size_t SocialGraph::Direction::deltaBytes() const {
+    size_t total = 0;
+    for (const auto* edits : {&added, &removed}) {
+        for (const auto& entry : *edits) {
+            // Node overhead plus members (large sets also carry a hash index)
+            total += sizeof(entry) + 2 * sizeof(void*) +
+                     entry.second.size() * (sizeof(UserIdx) + (entry.second.isLarge() ? 16 : 0));
+        }
+        total += edits->bucket_count() * sizeof(void*);
+    }
+    return total;
+}
+
+// ---------------------- Graph ----------------------
+SocialGraph::SocialGraph() : edges(0), pendingEdits(0) {
+    clear();
+}
+
+void SocialGraph::bulkLoad(size_t vertexCount, std::vector<std::pair<UserIdx, UserIdx>> follows) {
+    follows.erase(std::remove_if(follows.begin(), follows.end(),
+                                 [](const std::pair<UserIdx, UserIdx>& e) { return e.first == e.second; }),
+                  follows.end());
+    for (const auto& e : follows) {
+        vertexCount = std::max(vertexCount, static_cast<size_t>(std::max(e.first, e.second)) + 1);
+    }
+
+    out = Direction();
+    out.csr = buildCsr(vertexCount, follows, false);
+    in = Direction();
+    in.csr = buildCsr(vertexCount, follows, true);
+
+    edges = 0;
+    for (uint32_t degree : out.csr->degrees) edges += degree;
+
+    pendingEdits = 0;
+}
+
+bool SocialGraph::follow(UserIdx follower, UserIdx followee) {
+    if (follower == followee || out.contains(follower, followee)) return false;
+
+    out.add(follower, followee);
+    in.add(followee, follower);
+    edges++;
+    pendingEdits++;
+    return true;
+}
+
+bool SocialGraph::unfollow(UserIdx follower, UserIdx followee) {
+    if (!out.contains(follower, followee)) return false;
+
+    out.remove(follower, followee);
+    in.remove(followee, follower);
+    edges--;
+    pendingEdits++;
+    return true;
+}
+
+// Pending edits decide first; otherwise search whichever CSR list is shorter
+bool SocialGraph::isFollowing(UserIdx follower, UserIdx followee) const {
+    auto addIt = out.added.find(follower);
+    if (addIt != out.added.end() && addIt->second.contains(followee)) return true;
+    auto remIt = out.removed.find(follower);
+    if (remIt != out.removed.end() && remIt->second.contains(followee)) return false;
+
+    if (out.csr->degree(follower) <= in.csr->degree(followee)) {
+        return out.csr->contains(follower, followee);
+    }
+    return in.csr->contains(followee, follower);
+}
+
+size_t SocialGraph::followingCount(UserIdx u) const {
+    return out.count(u);
+}
+
+size_t SocialGraph::followerCount(UserIdx u) const {
+    return in.count(u);
+}
+
+void SocialGraph::following(UserIdx u, std::vector<UserIdx>& result) const {
+    out.list(u, result);
+}
+
+void SocialGraph::followers(UserIdx u, std::vector<UserIdx>& result) const {
+    in.list(u, result);
+}
+
+void SocialGraph::mergeDeltas() {
+    installMerge(prepareMerge());
+}
+
+SocialGraph::PreparedMerge SocialGraph::prepareMerge() const {
+    PreparedMerge merge;
+    merge.baseOut = out.csr;
+    merge.baseIn = in.csr;
+    merge.out = out.merged(merge.touchedOut);
+    merge.in = in.merged(merge.touchedIn);
+    return merge;
+}
+
+bool SocialGraph::installMerge(const PreparedMerge& merge) {
+    if (out.csr != merge.baseOut || in.csr != merge.baseIn) return false;
+    out.rebase(merge.out, merge.touchedOut);
+    in.rebase(merge.in, merge.touchedIn);
+    pendingEdits = out.deltaEdits();
+    return true;
+}
+
+void SocialGraph::clear() {
+    std::vector<std::pair<UserIdx, UserIdx>> none;
+    out = Direction();
+    out.csr = buildCsr(0, none, false);
+    in = Direction();
+    in.csr = buildCsr(0, none, true);
+    edges = 0;
+    pendingEdits = 0;
+}
+
+GraphMemoryStats SocialGraph::memoryStats() const {
+    GraphMemoryStats stats;
+    stats.vertices = std::max(out.csr->vertexCount(), in.csr->vertexCount());
+    stats.edges = edges;
+    stats.csrBytes = out.csr->memoryBytes() + in.csr->memoryBytes();
+    stats.deltaEdits = pendingEdits;
+    stats.deltaBytes = out.deltaBytes() + in.deltaBytes();
+    stats.plainBytes = edges * 2 * sizeof(UserIdx);
+    if (edges > 0) {
+        stats.bytesPerEdge = static_cast<double>(stats.csrBytes + stats.deltaBytes) / edges;
+    }
+    return stats;
+}
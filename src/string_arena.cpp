@@ -0,0 +1,74 @@
+#include "string_arena.h"
+#include "field_parser.h"
+#include <cstring>
+
+// The calling thread's current block
+struct ArenaCursor {
+    const StringArena* owner = nullptr;
+    char* next = nullptr;
+    char* end = nullptr;
+};
+static thread_local ArenaCursor cursor;
+
+StringArena::StringArena() : strings(0), bytesUsed(0), bytesReserved(0), chunkCount(0) {}
+
+char* StringArena::newChunk(size_t size) {
+    std::lock_guard<std::mutex> lock(chunkMutex);
+    chunks.emplace_back(new char[size]);
+    bytesReserved.fetch_add(size, std::memory_order_relaxed);
+    chunkCount.fetch_add(1, std::memory_order_relaxed);
+    return chunks.back().get();
+}
+
+// Large strings get a chunk of their own so they do not waste a block
+char* StringArena::allocate(size_t size) {
+    if (size > BLOCK_SIZE / 4) return newChunk(size);
+
+    if (cursor.owner != this || static_cast<size_t>(cursor.end - cursor.next) < size) {
+        cursor.owner = this;
+        cursor.next = newChunk(BLOCK_SIZE);
+        cursor.end = cursor.next + BLOCK_SIZE;
+    }
+    char* p = cursor.next;
+    cursor.next += size;
+    return p;
+}
+
+// Hand back the tail of the latest allocation, if it is still the latest
+void StringArena::release(char* end, size_t unused) {
+    if (cursor.owner == this && cursor.next == end) cursor.next -= unused;
+}
+
+std::string_view StringArena::store(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    char* p = allocate(text.size());
+    std::memcpy(p, text.data(), text.size());
+    strings.fetch_add(1, std::memory_order_relaxed);
+    bytesUsed.fetch_add(text.size(), std::memory_order_relaxed);
+    return std::string_view(p, text.size());
+}
+
+// Decoding never grows the text, so reserve the encoded size and trim
+std::string_view StringArena::storeDecoded(std::string_view encoded) {
+    if (encoded.empty()) return std::string_view();
+    char* p = allocate(encoded.size());
+    size_t size = percentDecodeInto(encoded, p);
+    release(p + encoded.size(), encoded.size() - size);
+    strings.fetch_add(1, std::memory_order_relaxed);
+    bytesUsed.fetch_add(size, std::memory_order_relaxed);
+    return std::string_view(p, size);
+}
+
+ArenaStats StringArena::stats() const {
+    ArenaStats s;
+    s.strings = strings.load(std::memory_order_relaxed);
+    s.bytesUsed = bytesUsed.load(std::memory_order_relaxed);
+    s.bytesReserved = bytesReserved.load(std::memory_order_relaxed);
+    s.chunks = chunkCount.load(std::memory_order_relaxed);
+    return s;
+}
+
+StringArena& textArena() {
+    static StringArena arena;
+    return arena;
+}
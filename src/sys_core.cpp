@@ -1,22 +1,34 @@
 #include "sys_core.h"
+#include "binary_snapshot.h"
 #include "../include/Utils.h"
+#include "field_parser.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <iterator>
 #include <mutex>
+#include <atomic>
+#include <cstdio>
 
 // ---------------------- Static Member Initialization ----------------------
 SystemCore* SystemCore::instance = nullptr;
 std::mutex SystemCore::instanceMutex;
 
 // ---------------------- Constructor / Destructor ----------------------
-SystemCore::SystemCore() {
+SystemCore::SystemCore()
+    : userCount(0), postCount(0),
+      feedStrategy(FeedStrategy::Hybrid), celebrityThreshold(1000), timelineCapacity(500),
+      mutationLog("data/mutations.log"), compactionStopping(false), graphMergeWanted(false),
+      likeFlushAt(std::chrono::steady_clock::time_point::max()),
+      compactionInterval(60), compactionMinLogBytes(64 * 1024) {
     log("INFO", "SystemCore initialized");
     nextUserID = 1000; // default starting point
     nextPostID = 1000;
 }
 
 SystemCore::~SystemCore() {
+    stopBackgroundCompaction();
+    flushLikes();
     log("INFO", "SystemCore destroyed");
 }
 
@@ -31,88 +43,590 @@ SystemCore& SystemCore::getInstance() {
 
 // ---------------------- Data Loading ----------------------
 void SystemCore::loadAllData() {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    WriteLock lock(coreMutex);
 
-    // Load Users
-    std::ifstream userFile("data/user.txt");
-    if (userFile.is_open()) {
-        std::string line;
-        int count = 0;
-        while (std::getline(userFile, line)) {
-            if (line.empty()) continue;
-            try {
-                User u = User::deserialize(line);
-                users[u.getUserID()] = u;
-                userNotifiers[u.getUserID()] = std::make_unique<PostNotifier>();
-                count++;
-            } catch (const std::exception& e) {
-                log("ERROR", "Failed to deserialize user: " + std::string(e.what()));
-            }
+    // Prefer the binary snapshot; the text files are the import format
+    if (!loadBinarySnapshot()) {
+        importTextData();
+    }
+
+    // Apply changes made since the snapshot, then keep logging new ones
+    replayMutationLog();
+    graph.mergeDeltas();
+    mutationLog.open();
+
+    GraphMemoryStats graphStats = graph.memoryStats();
+    log("INFO", "Follow graph: " + std::to_string(graphStats.edges) + " edges, " +
+        std::to_string(graphStats.csrBytes + graphStats.deltaBytes) + " bytes (" +
+        std::to_string(graphStats.bytesPerEdge) + " per edge)");
+    TextMemoryStats textStats = textMemoryStatsLocked();
+    log("INFO", "Post records: " + std::to_string(textStats.bytesPerPost) + " bytes per post (" +
+        std::to_string(textStats.legacyBytesPerPost) + " with per-record strings), text arena " +
+        std::to_string(textStats.arena.bytesReserved) + " bytes");
+
+    updateNextUserID();
+}
+
+// The searchable fields of a user; views stay valid after the record changes
+static UserText textOf(const User& u) {
+    return UserText{u.getUsername(), u.getName(), u.getBio()};
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+bool SystemCore::loadBinarySnapshot() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<User> loadedUsers;
+    std::vector<Post> loadedPosts;
+    std::vector<std::pair<UserIdx, UserIdx>> follows;
+    std::vector<std::pair<PostIdx, UserIdx>> likes;
+    try {
+        if (!BinarySnapshot::load("data/snapshot.bin", loadedUsers, loadedPosts, follows, likes)) {
+            return false;
         }
-        userFile.close();
-        log("INFO", "Loaded " + std::to_string(count) + " users");
-        updateNextUserID();
-    } else {
-        log("WARNING", "user.txt not found, starting fresh");
+    } catch (const std::exception& e) {
+        log("ERROR", "Failed to load snapshot.bin: " + std::string(e.what()));
+        return false;
     }
+    loadTimings = LoadTimings();
+    loadTimings.readMs = elapsedMs(start);
+    loadTimings.records = loadedUsers.size() + loadedPosts.size();
 
-    // Load Posts
-    std::ifstream postFile("data/posts.txt");
-    if (postFile.is_open()) {
-        std::string line;
-        int count = 0;
-        while (std::getline(postFile, line)) {
-            if (line.empty()) continue;
-            try {
-                Post p = Post::deserialize(line);
-                posts[p.getPostID()] = p;
-                count++;
-            } catch (const std::exception& e) {
-                log("ERROR", "Failed to deserialize post: " + std::string(e.what()));
-            }
+    start = std::chrono::steady_clock::now();
+    users.reserve(userIdTable().size());
+    usernameIndex.reserve(loadedUsers.size());
+    for (User& u : loadedUsers) {
+        storeUser(std::make_shared<User>(std::move(u)));
+    }
+    posts.reserve(postIdTable().size());
+    postTable.reserve(postIdTable().size());
+    for (Post& p : loadedPosts) {
+        storePost(std::make_shared<Post>(std::move(p)));
+    }
+    loadTimings.mergeMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    graph.bulkLoad(userIdTable().size(), std::move(follows));
+    buildAffinity(likes);
+    likeIndex.bulkLoad(std::move(likes));
+    buildLoadIndexes();
+    loadTimings.indexMs = elapsedMs(start);
+
+    log("INFO", "Loaded " + std::to_string(loadedUsers.size()) + " users and " +
+        std::to_string(loadedPosts.size()) + " posts from snapshot.bin");
+    logLoadTimings();
+    return true;
+}
+
+// A user line with its edge lists, which go to the graph rather than the record
+struct ParsedUser {
+    User user;
+    std::vector<UserIdx> followers;
+    std::vector<UserIdx> following;
+};
+
+// A post line with the users who liked it
+struct ParsedPost {
+    Post post;
+    std::vector<UserIdx> likedBy;
+};
+
+// Text import: read both files, parse newline-aligned chunks on the pool,
+// then merge the per-chunk results in file order
+void SystemCore::importTextData() {
+    loadTimings = LoadTimings();
+
+    auto start = std::chrono::steady_clock::now();
+    std::string userData, postData;
+    bool haveUsers = readWholeFile("data/user.txt", userData);
+    bool havePosts = readWholeFile("data/posts.txt", postData);
+    loadTimings.readMs = elapsedMs(start);
+
+    if (!haveUsers) log("WARNING", "user.txt not found, starting fresh");
+    if (!havePosts) log("WARNING", "posts.txt not found, starting fresh");
+
+    start = std::chrono::steady_clock::now();
+    auto userChunks = parseChunked<ParsedUser>(workerPool, userData,
+        [](std::string_view line) {
+            ParsedUser parsed;
+            parsed.user = User::deserialize(line, &parsed.followers, &parsed.following);
+            return parsed;
+        });
+    auto postChunks = parseChunked<ParsedPost>(workerPool, postData,
+        [](std::string_view line) {
+            ParsedPost parsed;
+            parsed.post = Post::deserialize(line, &parsed.likedBy);
+            return parsed;
+        });
+    loadTimings.parseMs = elapsedMs(start);
+    loadTimings.chunks = userChunks.size() + postChunks.size();
+
+    start = std::chrono::steady_clock::now();
+    size_t parsedUsers = 0, parsedPosts = 0, parsedEdges = 0;
+    for (const auto& chunk : userChunks) {
+        parsedUsers += chunk.records.size();
+        for (const ParsedUser& parsed : chunk.records) {
+            parsedEdges += parsed.followers.size() + parsed.following.size();
         }
-        postFile.close();
-        log("INFO", "Loaded " + std::to_string(count) + " posts");
-    } else {
-        log("WARNING", "posts.txt not found, starting fresh");
     }
+    size_t parsedLikes = 0;
+    for (const auto& chunk : postChunks) {
+        parsedPosts += chunk.records.size();
+        for (const ParsedPost& parsed : chunk.records) parsedLikes += parsed.likedBy.size();
+    }
+    users.reserve(userIdTable().size());
+    usernameIndex.reserve(parsedUsers);
+    posts.reserve(postIdTable().size());
+    postTable.reserve(postIdTable().size());
+
+    // Both edge lists are read; the graph drops the duplicate pairs
+    std::vector<std::pair<UserIdx, UserIdx>> follows;
+    follows.reserve(parsedEdges);
+    for (auto& chunk : userChunks) {
+        if (chunk.failures > 0) {
+            log("ERROR", "Failed to deserialize " + std::to_string(chunk.failures) +
+                " user(s): " + chunk.firstError);
+        }
+        for (ParsedUser& parsed : chunk.records) {
+            UserIdx self = parsed.user.getIdx();
+            for (UserIdx follower : parsed.followers) follows.emplace_back(follower, self);
+            for (UserIdx followee : parsed.following) follows.emplace_back(self, followee);
+            storeUser(std::make_shared<User>(std::move(parsed.user)));
+        }
+    }
+    std::vector<std::pair<PostIdx, UserIdx>> likes;
+    likes.reserve(parsedLikes);
+    for (auto& chunk : postChunks) {
+        if (chunk.failures > 0) {
+            log("ERROR", "Failed to deserialize " + std::to_string(chunk.failures) +
+                " post(s): " + chunk.firstError);
+        }
+        for (ParsedPost& parsed : chunk.records) {
+            PostIdx self = parsed.post.getIdx();
+            for (UserIdx liker : parsed.likedBy) likes.emplace_back(self, liker);
+            storePost(std::make_shared<Post>(std::move(parsed.post)));
+        }
+    }
+    loadTimings.mergeMs = elapsedMs(start);
+    loadTimings.records = parsedUsers + parsedPosts;
+
+    start = std::chrono::steady_clock::now();
+    graph.bulkLoad(userIdTable().size(), std::move(follows));
+    buildAffinity(likes);
+    likeIndex.bulkLoad(std::move(likes));
+    buildLoadIndexes();
+    loadTimings.indexMs = elapsedMs(start);
+
+    if (haveUsers) log("INFO", "Loaded " + std::to_string(parsedUsers) + " users");
+    if (havePosts) log("INFO", "Loaded " + std::to_string(parsedPosts) + " posts");
+    logLoadTimings();
+}
+
+// Reverse tally of the loaded likes, made before likeIndex takes them.
+// Duplicate pairs are dropped here first, as the like index drops them.
+void SystemCore::buildAffinity(std::vector<std::pair<PostIdx, UserIdx>>& likes) {
+    std::sort(likes.begin(), likes.end());
+    likes.erase(std::unique(likes.begin(), likes.end()), likes.end());
+
+    std::vector<std::pair<UserIdx, UserIdx>> userAuthor;
+    userAuthor.reserve(likes.size());
+    for (const auto& like : likes) {
+        if (postTable.contains(like.first)) {
+            userAuthor.emplace_back(like.second, postTable.author(like.first));
+        }
+    }
+    affinity.bulkLoad(std::move(userAuthor));
+}
+
+// Only the day before the newest post can be in a window. The clock is set
+// first, so posts can then be counted in any order.
+void SystemCore::rebuildTrending() {
+    trending.clear();
+    uint64_t newest = 0;
+    for (PostIdx idx = 0; idx < postTable.slots(); ++idx) {
+        if (postTable.contains(idx)) newest = std::max(newest, postTable.timestamp(idx));
+    }
+    if (newest == 0) return;
+
+    trending.advanceTo(newest);
+    const uint64_t span = TrendingHashtags::BUCKETS * TrendingHashtags::BUCKET_SECONDS;
+    for (PostIdx idx = 0; idx < postTable.slots(); ++idx) {
+        if (postTable.contains(idx) && postTable.timestamp(idx) + span > newest) {
+            trending.add(postTable.content(idx), postTable.timestamp(idx));
+        }
+    }
+}
+
+void SystemCore::rebuildSearchIndex() {
+    std::vector<std::pair<PostIdx, std::string_view>> postDocs;
+    postDocs.reserve(postCount);
+    for (PostIdx idx = 0; idx < postTable.slots(); ++idx) {
+        if (postTable.contains(idx)) postDocs.emplace_back(idx, postTable.content(idx));
+    }
+    std::vector<std::pair<UserIdx, UserText>> userDocs;
+    userDocs.reserve(userCount);
+    for (const auto& u : users) {
+        if (u) userDocs.emplace_back(u->getIdx(), textOf(*u));
+    }
+    search.build(workerPool, postDocs, userDocs);
+
+    SearchStats s = search.stats();
+    log("INFO", "Search index: " + std::to_string(s.postTerms + s.userTerms) + " terms, " +
+        std::to_string(s.postings) + " postings in " + std::to_string(s.listBytes / 1024) + " KB (" +
+        std::to_string(s.rawListBytes / 1024) + " KB uncompressed)");
+}
+
+// Per-record structures derived after a bulk load
+void SystemCore::buildLoadIndexes() {
+    rebuildAuthorIndex();
+    rebuildTrending();
+    rebuildSearchIndex();
+
+    if (userNotifiers.size() < users.size()) {
+        userNotifiers.resize(users.size());
+    }
+    for (size_t i = 0; i < users.size(); ++i) {
+        if (users[i] && !userNotifiers[i]) {
+            userNotifiers[i] = std::make_shared<PostNotifier>();
+        }
+    }
+}
+
+void SystemCore::logLoadTimings() {
+    log("INFO", "Load timings (ms): read " + std::to_string(loadTimings.readMs) +
+        ", parse " + std::to_string(loadTimings.parseMs) +
+        ", merge " + std::to_string(loadTimings.mergeMs) +
+        ", index " + std::to_string(loadTimings.indexMs) +
+        " [" + std::to_string(loadTimings.records) + " records, " +
+        std::to_string(loadTimings.chunks) + " chunks, " +
+        std::to_string(workerPool.size()) + " threads]");
+}
+
+LoadTimings SystemCore::getLoadTimings() const {
+    return loadTimings;
 }
 
 // ---------------------- Data Saving ----------------------
+// Full checkpoint: fold the log into a fresh snapshot and refresh the text export
 void SystemCore::saveAllData() {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    compactNow();
+    exportTextData();
+}
+
+void SystemCore::setFsyncPolicy(FsyncPolicy policy) {
+    mutationLog.setFsyncPolicy(policy);
+}
+
+// Callers hold coreMutex exclusively, since likes land under a shared lock and
+// the counts must match the liker lists. The graph copy shares the CSR arrays
+// and only duplicates pending edits.
+void SystemCore::captureView(std::vector<std::shared_ptr<const User>>& userView,
+                             std::vector<std::shared_ptr<const Post>>& postView,
+                             SocialGraph& graphView, LikeView& likeView) {
+    graphView = graph;
+    likeIndex.copyTo(likeView.likers);
+    likeView.counts.assign(posts.size(), 0);
+    for (PostIdx i = 0; i < postTable.slots(); ++i) {
+        if (postTable.contains(i)) likeView.counts[i] = postTable.likes(i);
+    }
+    userView.reserve(userCount);
+    for (const auto& u : users) {
+        if (u) userView.push_back(u);
+    }
+    postView.reserve(postCount);
+    for (const auto& p : posts) {
+        if (p) postView.push_back(p);
+    }
+}
+
+bool SystemCore::writeSnapshotFiles(const std::vector<std::shared_ptr<const User>>& userView,
+                                    const std::vector<std::shared_ptr<const Post>>& postView,
+                                    const SocialGraph& graphView,
+                                    const LikeView& likeView,
+                                    uint64_t& bytesWritten) {
+    if (!BinarySnapshot::write("data/snapshot.bin", userView, postView, graphView, likeView,
+                               bytesWritten)) {
+        log("ERROR", "Failed to write snapshot.bin");
+        return false;
+    }
+
+    log("INFO", "Saved " + std::to_string(userView.size()) + " users");
+    log("INFO", "Saved " + std::to_string(postView.size()) + " posts");
+    return true;
+}
+
+// ---------------------- Text Export ----------------------
+// Write to a temp file and rename it over the target so a crash
+// never leaves a half-written file behind
+static bool replaceFile(const std::string& tmpPath, const std::string& path) {
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+bool SystemCore::exportTextData() {
+    std::vector<std::shared_ptr<const User>> userView;
+    std::vector<std::shared_ptr<const Post>> postView;
+    SocialGraph graphView;
+    LikeView likeView;
+    {
+        WriteLock lock(coreMutex);
+        captureView(userView, postView, graphView, likeView);
+    }
 
     // Save Users
-    std::ofstream userFile("data/user.txt");
+    std::ofstream userFile("data/user.txt.tmp");
     if (userFile.is_open()) {
-        for (const auto& pair : users) {
-            userFile << pair.second.serialize() << "\n";
+        std::vector<UserIdx> followers, following;
+        for (const auto& u : userView) {
+            graphView.followers(u->getIdx(), followers);
+            graphView.following(u->getIdx(), following);
+            userFile << u->serialize(IdView(followers.data(), followers.size()),
+                                     IdView(following.data(), following.size())) << "\n";
         }
         userFile.close();
-        log("INFO", "Saved " + std::to_string(users.size()) + " users");
     } else {
         log("ERROR", "Failed to open user.txt for writing");
+        return false;
     }
 
     // Save Posts
-    std::ofstream postFile("data/posts.txt");
+    std::ofstream postFile("data/posts.txt.tmp");
     if (postFile.is_open()) {
-        for (const auto& pair : posts) {
-            postFile << pair.second.serialize() << "\n";
+        for (const auto& p : postView) {
+            postFile << p->serialize(likeView.count(p->getIdx()), likeView.likersOf(p->getIdx())) << "\n";
         }
         postFile.close();
-        log("INFO", "Saved " + std::to_string(posts.size()) + " posts");
     } else {
         log("ERROR", "Failed to open posts.txt for writing");
+        return false;
+    }
+
+    if (!replaceFile("data/user.txt.tmp", "data/user.txt") ||
+        !replaceFile("data/posts.txt.tmp", "data/posts.txt")) {
+        log("ERROR", "Failed to replace text export files");
+        return false;
+    }
+    return true;
+}
+
+// ---------------------- Snapshot Compaction ----------------------
+// Only the pointer copy and log rotation happen under coreMutex; writers
+// that touch a record still referenced by the view clone it first.
+bool SystemCore::compactNow() {
+    std::lock_guard<std::mutex> compactLock(compactionMutex);
+    auto start = std::chrono::steady_clock::now();
+    flushLikes();
+    // Periodic point to fold pending follow edits into the CSR arrays
+    mergeGraphDeltas();
+
+    std::vector<std::shared_ptr<const User>> userView;
+    std::vector<std::shared_ptr<const Post>> postView;
+    SocialGraph graphView;
+    LikeView likeView;
+    uint64_t logBytes;
+    {
+        WriteLock lock(coreMutex);
+        captureView(userView, postView, graphView, likeView);
+
+        logBytes = mutationLog.sizeBytes();
+        if (!mutationLog.rotate()) return false;
+    }
+
+    uint64_t bytesWritten = 0;
+    if (!writeSnapshotFiles(userView, postView, graphView, likeView, bytesWritten)) {
+        // The archived log segment stays and is replayed on next start
+        return false;
+    }
+    // write() synced the snapshot and its directory entry, so the archive
+    // is no longer the only durable copy of its records
+    mutationLog.dropArchive();
+
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    compactionStats.runs++;
+    compactionStats.lastDurationMs = ms;
+    compactionStats.lastBytesWritten = bytesWritten;
+    compactionStats.totalBytesWritten += bytesWritten;
+    compactionStats.lastLogBytesFolded = logBytes;
+
+    log("INFO", "Compaction wrote " + std::to_string(bytesWritten) + " bytes in " +
+        std::to_string(static_cast<long long>(ms)) + " ms");
+    return true;
+}
+
+void SystemCore::startBackgroundCompaction(std::chrono::seconds interval, uint64_t minLogBytes) {
+    stopBackgroundCompaction();
+
+    {
+        std::lock_guard<std::mutex> lock(compactionWaitMutex);
+        compactionStopping = false;
+        compactionInterval = interval;
+        compactionMinLogBytes = minLogBytes;
+    }
+    compactionThread = std::thread(&SystemCore::compactionLoop, this);
+}
+
+void SystemCore::stopBackgroundCompaction() {
+    {
+        std::lock_guard<std::mutex> lock(compactionWaitMutex);
+        compactionStopping = true;
+    }
+    compactionWake.notify_all();
+    if (compactionThread.joinable()) {
+        compactionThread.join();
+    }
+}
+
+// Sleeps until the next compaction or like flush is due, or a graph merge
+// is requested; work is done with compactionWaitMutex released
+void SystemCore::compactionLoop() {
+    std::unique_lock<std::mutex> lock(compactionWaitMutex);
+    auto due = std::chrono::steady_clock::now() + compactionInterval;
+    while (!compactionStopping) {
+        auto now = std::chrono::steady_clock::now();
+        if (graphMergeWanted) {
+            graphMergeWanted = false;
+            lock.unlock();
+            mergeGraphDeltas();
+            lock.lock();
+        } else if (now >= likeFlushAt) {
+            likeFlushAt = std::chrono::steady_clock::time_point::max();
+            lock.unlock();
+            flushLikes();
+            lock.lock();
+        } else if (now >= due) {
+            due = now + compactionInterval;
+            lock.unlock();
+            flushLikes();
+            if (mutationLog.sizeBytes() >= compactionMinLogBytes) {
+                compactNow();
+            }
+            lock.lock();
+        } else {
+            compactionWake.wait_until(lock, std::min(due, likeFlushAt));
+        }
+    }
+}
+
+// Called with coreMutex held by a follow or unfollow that found a merge due
+void SystemCore::requestGraphMerge() {
+    {
+        std::lock_guard<std::mutex> lock(compactionWaitMutex);
+        if (graphMergeWanted) return;
+        graphMergeWanted = true;
+    }
+    compactionWake.notify_all();
+}
+
+// Called by queueLike when a like starts a new batch
+void SystemCore::scheduleLikeFlush(std::chrono::steady_clock::time_point at) {
+    {
+        std::lock_guard<std::mutex> lock(compactionWaitMutex);
+        if (at >= likeFlushAt) return;
+        likeFlushAt = at;
+    }
+    compactionWake.notify_all();
+}
+
+// The new CSR arrays are built from a copy of the graph without holding
+// coreMutex; the exclusive lock only covers re-basing the edits made
+// since the copy onto them
+void SystemCore::mergeGraphDeltas() {
+    SocialGraph view;
+    {
+        ReadLock lock(coreMutex);
+        if (graph.pendingEditCount() == 0) return;
+        view = graph;
+    }
+    SocialGraph::PreparedMerge merge = view.prepareMerge();
+    WriteLock lock(coreMutex);
+    graph.installMerge(merge);
+}
+
+CompactionStats SystemCore::getCompactionStats() {
+    std::lock_guard<std::mutex> lock(compactionMutex);
+    return compactionStats;
+}
+
+// ---------------------- Mutation Log ----------------------
+uint64_t SystemCore::logMutation(MutationType type, const std::string& payload) {
+    return mutationLog.append(Mutation{type, payload});
+}
+
+void SystemCore::replayMutationLog() {
+    size_t count = mutationLog.replay([this](const Mutation& m) { applyMutation(m); });
+    if (count > 0) {
+        log("INFO", "Replayed " + std::to_string(count) + " logged changes");
+    }
+}
+
+// Every record is idempotent so replaying over a newer snapshot is safe
+void SystemCore::applyMutation(const Mutation& m) {
+    std::vector<std::string> parts = safeSplit(m.payload, '|');
+
+    switch (m.type) {
+        case MutationType::AddUser:
+            addUserLocked(User::deserialize(m.payload));
+            break;
+        case MutationType::AddPost:
+            addPostLocked(Post::deserialize(m.payload));
+            break;
+        case MutationType::Follow:
+            if (parts.size() < 2) throw std::runtime_error("Invalid follow record");
+            followLocked(parts[0], parts[1]);
+            break;
+        case MutationType::Unfollow:
+            if (parts.size() < 2) throw std::runtime_error("Invalid unfollow record");
+            unfollowLocked(parts[0], parts[1]);
+            break;
+        case MutationType::Like: {
+            if (parts.size() < 2) throw std::runtime_error("Invalid like record");
+            PostIdx postIdx = postIdTable().find(parts[0]);
+            if (findPost(postIdx)) postTable.setLikes(postIdx, std::stoi(parts[1]));
+            break;
+        }
+        case MutationType::LikedBy: {
+            if (parts.size() < 2) throw std::runtime_error("Invalid like record");
+            PostIdx postIdx = postIdTable().find(parts[0]);
+            const User* user = findUser(userIdTable().find(parts[1]));
+            const Post* post = findPost(postIdx);
+            if (post && user && likeIndex.add(postIdx, user->getIdx())) {
+                postTable.addLike(postIdx);
+                affinity.add(user->getIdx(), post->getAuthorIdx());
+            }
+            break;
+        }
+        case MutationType::EditPost: {
+            if (parts.size() < 2) throw std::runtime_error("Invalid edit record");
+            Post* post = mutablePost(postIdTable().find(parts[0]));
+            if (post) editPostLocked(*post, urlDecode(parts[1]));
+            break;
+        }
+        case MutationType::EditProfile: {
+            if (parts.empty()) throw std::runtime_error("Invalid profile record");
+            User* user = mutableUser(userIdTable().find(parts[0]));
+            if (user) {
+                UserText before = textOf(*user);
+                user->setName(parts.size() > 1 ? urlDecode(parts[1]) : "");
+                user->setBio(parts.size() > 2 ? urlDecode(parts[2]) : "");
+                reindexUser(*user, before);
+            }
+            break;
+        }
     }
 }
 
 // ---------------------- Helper: User ID ----------------------
 void SystemCore::updateNextUserID() {
     int maxID = 999; // so next becomes u_1000 if empty
-    for (const auto& [id, user] : users) {
+    for (const auto& user : users) {
+        if (!user) continue;
         try {
-            int num = std::stoi(id.substr(2)); // remove "u_"
+            int num = std::stoi(user->getUserID().substr(2)); // remove "u_"
             if (num > maxID) maxID = num;
         } catch (...) {
             continue;
@@ -124,9 +638,10 @@ void SystemCore::updateNextUserID() {
 
 void SystemCore::updateNextPostID() {
     int maxID = 999; // start default
-    for (const auto& [id, post] : posts) {
+    for (const auto& post : posts) {
+        if (!post) continue;
         try {
-            int num = std::stoi(id.substr(2)); // remove "p_"
+            int num = std::stoi(post->getPostID().substr(2)); // remove "p_"
             if (num > maxID) maxID = num;
         } catch (...) { continue; }
     }
@@ -136,189 +651,1253 @@ void SystemCore::updateNextPostID() {
 
 
 std::string SystemCore::generateUserID() {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    WriteLock lock(coreMutex);
     return "u_" + std::to_string(nextUserID++);
 }
 
 std::string SystemCore::generatePostID() {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    WriteLock lock(coreMutex);
     return "p_" + std::to_string(nextPostID++);
 }
 
 
 // ---------------------- User Management ----------------------
-User* SystemCore::getUser(const std::string& userID) {
-    auto it = users.find(userID);
-    return (it != users.end()) ? &(it->second) : nullptr;
+std::shared_ptr<const User> SystemCore::getUser(const std::string& userID) {
+    ReadLock lock(coreMutex);
+    UserIdx idx = userIdTable().find(userID);
+    return (idx < users.size()) ? users[idx] : nullptr;
+}
+
+const User* SystemCore::findUser(UserIdx idx) const {
+    return (idx < users.size()) ? users[idx].get() : nullptr;
+}
+
+// Copy-on-write: published records may be in use by readers and snapshots
+// without any lock, so a change always goes to a fresh copy
+User* SystemCore::mutableUser(UserIdx idx) {
+    if (idx >= users.size() || !users[idx]) return nullptr;
+    users[idx] = std::make_shared<User>(*users[idx]);
+    return users[idx].get();
+}
+
+// Place a record in its slot, replacing any earlier record with the same ID
+void SystemCore::storeUser(std::shared_ptr<User> u) {
+    UserIdx idx = u->getIdx();
+    if (idx >= users.size()) users.resize(idx + 1);
+    if (!users[idx]) {
+        userCount++;
+    } else if (users[idx]->getUsername() != u->getUsername()) {
+        auto old = usernameIndex.find(users[idx]->getUsername());
+        if (old != usernameIndex.end() && old->second == idx) usernameIndex.erase(old);
+    }
+    // The first holder of a name keeps it if the data files repeat one
+    usernameIndex.emplace(u->getUsername(), idx);
+    if (idx >= homeTimelines.size()) homeTimelines.resize(idx + 1);
+    inboxes.ensureUser(idx);
+    if (idx >= inboxReadMarks.size()) {
+        // Pulled posts count from when the inbox came into being
+        inboxReadMarks.resize(idx + 1, FeedKey{currentTimestamp(), 0});
+    }
+    users[idx] = std::move(u);
 }
 
 bool SystemCore::addUser(const User& u) {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        if (!addUserLocked(u)) return false;
+        seq = logMutation(MutationType::AddUser, u.serialize());
+    }
+    return mutationLog.commit(seq);
+}
 
-    if (usernameExists(u.getUsername())) {
-        log("WARNING", "Username already exists: " + u.getUsername());
+bool SystemCore::addUserLocked(const User& u) {
+    if (usernameIndex.count(u.getUsername()) > 0) {
+        log("WARNING", "Username already exists: " + std::string(u.getUsername()));
         return false;
     }
 
-    if (users.find(u.getUserID()) != users.end()) {
+    if (findUser(u.getIdx())) {
         log("WARNING", "User already exists: " + u.getUserID());
         return false;
     }
 
-    users[u.getUserID()] = u;
-    userNotifiers[u.getUserID()] = std::make_unique<PostNotifier>();
+    storeUser(std::make_shared<User>(u));
+    search.addUser(u.getIdx(), textOf(u));
+    if (u.getIdx() >= userNotifiers.size()) userNotifiers.resize(u.getIdx() + 1);
+    userNotifiers[u.getIdx()] = std::make_shared<PostNotifier>();
     log("INFO", "User added: " + u.getUserID());
     return true;
 }
 
 bool SystemCore::userExists(const std::string& userID) {
-    return users.find(userID) != users.end();
+    return getUser(userID) != nullptr;
 }
 
 bool SystemCore::usernameExists(const std::string& username) {
-    for (const auto& pair : users) {
-        if (pair.second.getUsername() == username) {
-            return true;
-        }
-    }
-    return false;
+    ReadLock lock(coreMutex);
+    return usernameIndex.count(username) > 0;
+}
+
+std::shared_ptr<const User> SystemCore::findUserByUsername(const std::string& username) {
+    ReadLock lock(coreMutex);
+    auto it = usernameIndex.find(username);
+    return (it != usernameIndex.end()) ? users[it->second] : nullptr;
 }
 
 std::vector<User> SystemCore::getAllUsers() {
+    ReadLock lock(coreMutex);
     std::vector<User> result;
-    for (const auto& pair : users) {
-        result.push_back(pair.second);
+    result.reserve(userCount);
+    for (const auto& u : users) {
+        if (u) result.push_back(*u);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<const User>> SystemCore::getUserList() {
+    ReadLock lock(coreMutex);
+    std::vector<std::shared_ptr<const User>> result;
+    result.reserve(userCount);
+    for (const auto& u : users) {
+        if (u) result.push_back(u);
+    }
+    return result;
+}
+
+// Edges are stored as indexes; these resolve them for callers that want IDs
+std::vector<std::string> SystemCore::getFollowingIDs(const std::string& userID) {
+    ReadLock lock(coreMutex);
+    std::vector<std::string> result;
+    const User* user = findUser(userIdTable().find(userID));
+    if (!user) return result;
+
+    std::vector<UserIdx> ids;
+    graph.following(user->getIdx(), ids);
+    for (UserIdx idx : ids) {
+        result.push_back(userIdTable().name(idx));
     }
     return result;
 }
 
+std::vector<std::string> SystemCore::getFollowerIDs(const std::string& userID) {
+    ReadLock lock(coreMutex);
+    std::vector<std::string> result;
+    const User* user = findUser(userIdTable().find(userID));
+    if (!user) return result;
+
+    std::vector<UserIdx> ids;
+    graph.followers(user->getIdx(), ids);
+    for (UserIdx idx : ids) {
+        result.push_back(userIdTable().name(idx));
+    }
+    return result;
+}
+
+bool SystemCore::isFollowing(const std::string& followerID, const std::string& followeeID) {
+    UserIdx follower = userIdTable().find(followerID);
+    UserIdx followee = userIdTable().find(followeeID);
+    if (follower == INVALID_IDX || followee == INVALID_IDX) return false;
+    ReadLock lock(coreMutex);
+    return graph.isFollowing(follower, followee);
+}
+
+int SystemCore::getFollowerCount(const std::string& userID) {
+    UserIdx idx = userIdTable().find(userID);
+    if (idx == INVALID_IDX) return 0;
+    ReadLock lock(coreMutex);
+    return static_cast<int>(graph.followerCount(idx));
+}
+
+int SystemCore::getFollowingCount(const std::string& userID) {
+    UserIdx idx = userIdTable().find(userID);
+    if (idx == INVALID_IDX) return 0;
+    ReadLock lock(coreMutex);
+    return static_cast<int>(graph.followingCount(idx));
+}
+
+GraphMemoryStats SystemCore::getGraphMemoryStats() {
+    ReadLock lock(coreMutex);
+    return graph.memoryStats();
+}
+
+// Heap cost of a std::string holding len bytes: inline up to the SSO
+// limit, otherwise a malloc block (8-byte header, 16-byte granules)
+static size_t legacyStringBytes(size_t len) {
+    size_t bytes = sizeof(std::string);
+    if (len > 15) bytes += std::max<size_t>(32, (len + 1 + 8 + 15) & ~size_t(15));
+    return bytes;
+}
+
+TextMemoryStats SystemCore::getTextMemoryStats() {
+    ReadLock lock(coreMutex);
+    return textMemoryStatsLocked();
+}
+
+TextMemoryStats SystemCore::textMemoryStatsLocked() const {
+    TextMemoryStats stats;
+    stats.arena = textArena().stats();
+
+    // Arena layout: the record plus its text bytes. Legacy layout: the same
+    // record with std::string members in place of the views.
+    const size_t postFixed = sizeof(Post) - sizeof(std::string_view);
+    const size_t userFixed = sizeof(User) - 3 * sizeof(std::string_view);
+    size_t bytes = 0, legacy = 0;
+    for (const auto& p : posts) {
+        if (!p) continue;
+        size_t len = p->contentSize();
+        stats.posts++;
+        bytes += sizeof(Post) + len;
+        legacy += postFixed + legacyStringBytes(len);
+    }
+    if (stats.posts > 0) {
+        stats.bytesPerPost = static_cast<double>(bytes) / stats.posts;
+        stats.legacyBytesPerPost = static_cast<double>(legacy) / stats.posts;
+    }
+
+    bytes = legacy = 0;
+    for (const auto& u : users) {
+        if (!u) continue;
+        stats.users++;
+        size_t lens[3];
+        u->textSizes(lens);
+        bytes += sizeof(User);
+        legacy += userFixed;
+        for (size_t len : lens) {
+            bytes += len;
+            legacy += legacyStringBytes(len);
+        }
+    }
+    if (stats.users > 0) {
+        stats.bytesPerUser = static_cast<double>(bytes) / stats.users;
+        stats.legacyBytesPerUser = static_cast<double>(legacy) / stats.users;
+    }
+    return stats;
+}
+
+bool SystemCore::updateUserName(const std::string& userID, const std::string& name) {
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        User* user = mutableUser(userIdTable().find(userID));
+        if (!user) return false;
+
+        UserText before = textOf(*user);
+        user->setName(name);
+        reindexUser(*user, before);
+        seq = logMutation(MutationType::EditProfile,
+                          userID + "|" + urlEncode(user->getName()) + "|" + urlEncode(user->getBio()));
+    }
+    return mutationLog.commit(seq);
+}
+
+bool SystemCore::updateUserBio(const std::string& userID, const std::string& bio) {
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        User* user = mutableUser(userIdTable().find(userID));
+        if (!user) return false;
+
+        UserText before = textOf(*user);
+        user->setBio(bio);
+        reindexUser(*user, before);
+        seq = logMutation(MutationType::EditProfile,
+                          userID + "|" + urlEncode(user->getName()) + "|" + urlEncode(user->getBio()));
+    }
+    return mutationLog.commit(seq);
+}
+
+// Caller captured before ahead of changing the record made by mutableUser
+void SystemCore::reindexUser(const User& user, const UserText& before) {
+    search.updateUser(user.getIdx(), before, textOf(user));
+}
+
 // ---------------------- Post Management ----------------------
-Post* SystemCore::getPost(const std::string& postID) {
-    auto it = posts.find(postID);
-    return (it != posts.end()) ? &(it->second) : nullptr;
+std::shared_ptr<const Post> SystemCore::getPost(const std::string& postID) {
+    ReadLock lock(coreMutex);
+    PostIdx idx = postIdTable().find(postID);
+    return (idx < posts.size()) ? posts[idx] : nullptr;
+}
+
+const Post* SystemCore::findPost(PostIdx idx) const {
+    return (idx < posts.size()) ? posts[idx].get() : nullptr;
+}
+
+Post* SystemCore::mutablePost(PostIdx idx) {
+    if (idx >= posts.size() || !posts[idx]) return nullptr;
+    posts[idx] = std::make_shared<Post>(*posts[idx]);
+    return posts[idx].get();
+}
+
+void SystemCore::storePost(std::shared_ptr<Post> p) {
+    PostIdx idx = p->getIdx();
+    if (idx >= posts.size()) posts.resize(idx + 1);
+    if (!posts[idx]) postCount++;
+    postTable.store(*p);
+    posts[idx] = std::move(p);
 }
 
 bool SystemCore::addPost(const Post& p) {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    uint64_t seq;
+    std::shared_ptr<PostNotifier> notifier;
+    std::shared_ptr<const Post> stored;
+    {
+        WriteLock lock(coreMutex);
+        if (!addPostLocked(p)) return false;
+        seq = logMutation(MutationType::AddPost, p.serialize());
+        deliverToInboxes(p);
+        notifier = notifierFor(p.getAuthorIdx());
+        stored = posts[p.getIdx()];
+    }
+    bool durable = mutationLog.commit(seq);
 
-    if (posts.find(p.getPostID()) != posts.end()) {
+    // Notify followers
+    notifications.enqueue(std::move(notifier), std::move(stored));
+    return durable;
+}
+
+bool SystemCore::addPostLocked(const Post& p) {
+    if (findPost(p.getIdx())) {
         log("WARNING", "Post already exists: " + p.getPostID());
         return false;
     }
 
-    posts[p.getPostID()] = p;
+    storePost(std::make_shared<Post>(p));
+    indexPost(p);
+    fanOutPost(p);
+    trending.add(p.getContent(), p.getTimestamp());
+    search.addPost(p.getIdx(), p.getContent());
     log("INFO", "Post added: " + p.getPostID());
-
-    // Notify followers
-    notifyFollowers(p.getUserID(), p);
-
     return true;
 }
 
-std::vector<Post> SystemCore::getPostsByUser(const std::string& userID) {
-    std::vector<Post> result;
-    for (const auto& pair : posts) {
-        if (pair.second.getUserID() == userID) {
-            result.push_back(pair.second);
-        }
+// Newest first
+std::vector<PostRef> SystemCore::getPostsByUser(const std::string& userID) {
+    ReadLock lock(coreMutex);
+    static const std::vector<PostIdx> none;
+    UserIdx author = userIdTable().find(userID);
+    const std::vector<PostIdx>& handles = (author < postsByAuthor.size()) ? postsByAuthor[author] : none;
+    std::vector<PostRef> result;
+    result.reserve(handles.size());
+    for (auto it = handles.rbegin(); it != handles.rend(); ++it) {
+        result.push_back(posts[*it]);
     }
     return result;
 }
 
+// Handles into the post store, oldest first; use getPostByIdx to reach
+// the records. Handles are copied since the list grows with every addPost.
+std::vector<PostIdx> SystemCore::getPostIndexByUser(const std::string& userID) const {
+    ReadLock lock(coreMutex);
+    UserIdx author = userIdTable().find(userID);
+    return (author < postsByAuthor.size()) ? postsByAuthor[author] : std::vector<PostIdx>();
+}
+
+std::shared_ptr<const Post> SystemCore::getPostByIdx(PostIdx idx) const {
+    ReadLock lock(coreMutex);
+    return (idx < posts.size()) ? posts[idx] : nullptr;
+}
+
+size_t SystemCore::getPostCountByUser(const std::string& userID) const {
+    ReadLock lock(coreMutex);
+    UserIdx author = userIdTable().find(userID);
+    return (author < postsByAuthor.size()) ? postsByAuthor[author].size() : 0;
+}
+
 std::vector<Post> SystemCore::getAllPosts() {
+    ReadLock lock(coreMutex);
     std::vector<Post> result;
-    for (const auto& pair : posts) {
-        result.push_back(pair.second);
+    result.reserve(postCount);
+    for (const auto& p : posts) {
+        if (p) result.push_back(*p);
     }
     return result;
 }
 
+std::vector<PostIdx> SystemCore::getTopPosts(size_t k, PostOrder order) const {
+    ReadLock lock(coreMutex);
+    std::vector<PostIdx> handles;
+    postTable.top(k, order, handles);
+    return handles;
+}
+
+// Handles that are not stored posts are dropped first
+void SystemCore::sortPostHandles(std::vector<PostIdx>& handles, PostOrder order) const {
+    ReadLock lock(coreMutex);
+    handles.erase(std::remove_if(handles.begin(), handles.end(),
+                                 [this](PostIdx idx) { return !postTable.contains(idx); }),
+                  handles.end());
+    postTable.sort(handles, order);
+}
+
+uint64_t SystemCore::getTotalLikes() const {
+    ReadLock lock(coreMutex);
+    return postTable.totalLikes();
+}
+
+// ---------------------- Author Index ----------------------
+// Posts usually arrive in time order, so the insert point is nearly always the end
+void SystemCore::indexPost(const Post& p) {
+    UserIdx author = p.getAuthorIdx();
+    if (author >= postsByAuthor.size()) postsByAuthor.resize(author + 1);
+    insertByKey(postsByAuthor[author], p.getIdx());
+}
+
+// Keeps list oldest first (by timestamp, then PostIdx)
+void SystemCore::insertByKey(std::vector<PostIdx>& list, PostIdx post) const {
+    FeedKey key = postTable.key(post);
+    auto pos = list.end();
+    while (pos != list.begin() && !olderThan(postTable.key(*(pos - 1)), key)) {
+        --pos;
+    }
+    list.insert(pos, post);
+}
+
+void SystemCore::rebuildAuthorIndex() {
+    postsByAuthor.assign(userIdTable().size(), {});
+    for (PostIdx idx = 0; idx < postTable.slots(); ++idx) {
+        if (postTable.contains(idx)) postsByAuthor[postTable.author(idx)].push_back(idx);
+    }
+
+    auto older = [this](PostIdx a, PostIdx b) {
+        return olderThan(postTable.key(a), postTable.key(b));
+    };
+    for (std::vector<PostIdx>& list : postsByAuthor) {
+        if (!std::is_sorted(list.begin(), list.end(), older)) {
+            std::sort(list.begin(), list.end(), older);
+        }
+    }
+}
+
+// ---------------------- Likes ----------------------
+// Likes bypass copy-on-write: the count is an atomic in postTable's likes
+// column, which every copy of the record reads, and membership has its
+// own lock shards, so concurrent likes share coreMutex.
+// Snapshots take their counts from captureView rather than the records.
+bool SystemCore::likePost(const std::string& userID, const std::string& postID) {
+    UserIdx userIdx;
+    PostIdx postIdx;
+    {
+        ReadLock lock(coreMutex);
+        const User* user = findUser(userIdTable().find(userID));
+        postIdx = postIdTable().find(postID);
+        if (!user || !findPost(postIdx)) return false;
+
+        userIdx = user->getIdx();
+        if (!likeIndex.add(postIdx, userIdx)) return false;
+        postTable.addLike(postIdx);
+        affinity.add(userIdx, postTable.author(postIdx));
+    }
+    queueLike(postIdx, userIdx);
+    return true;
+}
+
+bool SystemCore::hasLiked(const std::string& userID, const std::string& postID) {
+    UserIdx userIdx = userIdTable().find(userID);
+    PostIdx postIdx = postIdTable().find(postID);
+    if (userIdx == INVALID_IDX || postIdx == INVALID_IDX) return false;
+    return likeIndex.contains(postIdx, userIdx);
+}
+
+// Like records are replay-idempotent, so a batch may land on either side of
+// a log rotation without double counting
+// A full or expired batch is written by the caller that finds it so; the
+// compaction thread writes a batch that stops growing once it expires
+void SystemCore::queueLike(PostIdx post, UserIdx user) {
+    std::vector<std::pair<PostIdx, UserIdx>> batch;
+    bool started = false;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(likeBatchMutex);
+        if (pendingLikes.empty()) {
+            pendingLikesSince = now;
+            started = true;
+        }
+        pendingLikes.emplace_back(post, user);
+        if (pendingLikes.size() >= LIKE_BATCH_SIZE || now - pendingLikesSince >= LIKE_BATCH_WINDOW) {
+            batch.swap(pendingLikes);
+        }
+    }
+    if (batch.empty()) {
+        if (started) scheduleLikeFlush(now + LIKE_BATCH_WINDOW);
+        return;
+    }
+    writeLikeBatch(batch);
+}
+
+void SystemCore::flushLikes() {
+    std::vector<std::pair<PostIdx, UserIdx>> batch;
+    {
+        std::lock_guard<std::mutex> lock(likeBatchMutex);
+        batch.swap(pendingLikes);
+    }
+    writeLikeBatch(batch);
+}
+
+// One group commit for the whole batch
+void SystemCore::writeLikeBatch(const std::vector<std::pair<PostIdx, UserIdx>>& batch) {
+    if (batch.empty()) return;
+
+    uint64_t seq = 0;
+    for (const auto& like : batch) {
+        seq = logMutation(MutationType::LikedBy,
+                          postIdTable().name(like.first) + "|" + userIdTable().name(like.second));
+    }
+    mutationLog.commit(seq);
+}
+
+// New text for a record already made private by mutablePost
+void SystemCore::editPostLocked(Post& post, const std::string& newContent) {
+    std::string_view before = post.getContent();
+    post.editContent(newContent);
+    postTable.store(post);
+    search.updatePost(post.getIdx(), before, post.getContent());
+}
+
+bool SystemCore::editPost(const std::string& postID, const std::string& newContent) {
+    if (newContent.empty()) return false;
+
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        Post* post = mutablePost(postIdTable().find(postID));
+        if (!post) return false;
+
+        editPostLocked(*post, newContent);
+        seq = logMutation(MutationType::EditPost, postID + "|" + urlEncode(newContent));
+    }
+    return mutationLog.commit(seq);
+}
+
 // ---------------------- Follow Operations ----------------------
 bool SystemCore::followUser(const std::string& followerID, const std::string& followeeID) {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        if (!followLocked(followerID, followeeID)) return false;
+        seq = logMutation(MutationType::Follow, followerID + "|" + followeeID);
+    }
+    return mutationLog.commit(seq);
+}
 
-    User* follower = getUser(followerID);
-    User* followee = getUser(followeeID);
+bool SystemCore::followLocked(const std::string& followerID, const std::string& followeeID) {
+    const User* follower = findUser(userIdTable().find(followerID));
+    const User* followee = findUser(userIdTable().find(followeeID));
 
     if (!follower || !followee) {
         log("ERROR", "User not found in follow operation");
         return false;
     }
 
-    follower->follow(followeeID);
-    followee->addFollower(followerID);
+    // Following twice (or yourself) succeeds without changing anything
+    if (graph.follow(follower->getIdx(), followee->getIdx())) {
+        if (graph.mergeDue()) requestGraphMerge();
+        invalidateTimeline(follower->getIdx());
+        countFollowEdit(follower->getIdx());
+        if (feedStrategy == FeedStrategy::Hybrid &&
+            graph.followerCount(followee->getIdx()) == celebrityThreshold) {
+            // Just became a celebrity: followers' timelines hold pushed posts
+            invalidateFollowerTimelines(followee->getIdx());
+        }
+    }
 
     log("INFO", followerID + " followed " + followeeID);
     return true;
 }
 
 bool SystemCore::unfollowUser(const std::string& followerID, const std::string& followeeID) {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    uint64_t seq;
+    {
+        WriteLock lock(coreMutex);
+        if (!unfollowLocked(followerID, followeeID)) return false;
+        seq = logMutation(MutationType::Unfollow, followerID + "|" + followeeID);
+    }
+    return mutationLog.commit(seq);
+}
 
-    User* follower = getUser(followerID);
-    User* followee = getUser(followeeID);
+bool SystemCore::unfollowLocked(const std::string& followerID, const std::string& followeeID) {
+    const User* follower = findUser(userIdTable().find(followerID));
+    const User* followee = findUser(userIdTable().find(followeeID));
 
     if (!follower || !followee) {
         log("ERROR", "User not found in unfollow operation");
         return false;
     }
 
-    follower->unfollow(followeeID);
-    followee->removeFollower(followerID);
+    if (graph.unfollow(follower->getIdx(), followee->getIdx())) {
+        if (graph.mergeDue()) requestGraphMerge();
+        invalidateTimeline(follower->getIdx());
+        countFollowEdit(follower->getIdx());
+        if (feedStrategy == FeedStrategy::Hybrid &&
+            graph.followerCount(followee->getIdx()) + 1 == celebrityThreshold) {
+            // No longer a celebrity: followers' timelines lack their posts
+            invalidateFollowerTimelines(followee->getIdx());
+        }
+    }
     
     log("INFO", followerID + " unfollowed " + followeeID);
     return true;
 }
 
 // ---------------------- Observer Pattern ----------------------
+// Notifiers guard their own observer lists, so a shared lock is enough here
 void SystemCore::registerObserverForUser(const std::string& userID, IObserver* observer) {
-    if (userNotifiers.find(userID) != userNotifiers.end()) {
-        userNotifiers[userID]->registerObserver(observer);
+    std::shared_ptr<PostNotifier> notifier;
+    {
+        ReadLock lock(coreMutex);
+        notifier = notifierFor(userIdTable().find(userID));
     }
+    if (notifier) notifier->registerObserver(observer);
+}
+
+void SystemCore::removeObserverForUser(const std::string& userID, IObserver* observer) {
+    std::shared_ptr<PostNotifier> notifier;
+    {
+        ReadLock lock(coreMutex);
+        notifier = notifierFor(userIdTable().find(userID));
+    }
+    if (!notifier) return;
+    notifier->removeObserver(observer);
+    // A batch that read the old list may still be calling it
+    notifications.quiesce();
 }
 
 void SystemCore::notifyFollowers(const std::string& userID, const Post& p) {
-    if (userNotifiers.find(userID) != userNotifiers.end()) {
-        userNotifiers[userID]->notifyObservers(p);
+    std::shared_ptr<PostNotifier> notifier;
+    {
+        ReadLock lock(coreMutex);
+        notifier = notifierFor(userIdTable().find(userID));
+    }
+    notifications.enqueue(std::move(notifier), std::make_shared<const Post>(p));
+}
+
+void SystemCore::flushNotifications() {
+    notifications.drain();
+}
+
+NotificationStats SystemCore::getNotificationStats() const {
+    return notifications.getStats();
+}
+
+std::shared_ptr<PostNotifier> SystemCore::notifierFor(UserIdx author) const {
+    return (author < userNotifiers.size()) ? userNotifiers[author] : nullptr;
+}
+
+// ---------------------- Inboxes ----------------------
+// Every follower of a regular author; replayed posts are not delivered again.
+// A celebrity's post is recorded for pulling instead, so later reads don't
+// depend on the author's follower count at that time.
+void SystemCore::deliverToInboxes(const Post& p) {
+    UserIdx author = p.getAuthorIdx();
+    if (isInboxPulled(author)) {
+        if (author >= pulledInboxPosts.size()) pulledInboxPosts.resize(author + 1);
+        insertByKey(pulledInboxPosts[author], p.getIdx());
+        return;
+    }
+    std::vector<UserIdx> followers;
+    graph.followers(p.getAuthorIdx(), followers);
+    for (UserIdx followerIdx : followers) {
+        inboxes.push(followerIdx, p.getIdx());
+    }
+}
+
+// Pushing one post to every follower of a large account would hold the
+// exclusive lock for the whole fan-out. Only asked when a post is made.
+bool SystemCore::isInboxPulled(UserIdx author) const {
+    return graph.followerCount(author) >= celebrityThreshold;
+}
+
+std::vector<SystemCore::FeedSource> SystemCore::pulledInboxSources(UserIdx user) const {
+    std::vector<UserIdx> following;
+    graph.following(user, following);
+
+    std::vector<FeedSource> sources;
+    for (UserIdx followedIdx : following) {
+        if (followedIdx >= pulledInboxPosts.size() || pulledInboxPosts[followedIdx].empty()) continue;
+        const std::vector<PostIdx>& list = pulledInboxPosts[followedIdx];
+        sources.push_back(FeedSource{list.data(), list.size()});
+    }
+    return sources;
+}
+
+size_t SystemCore::getUnreadCount(const std::string& userID) {
+    UserIdx idx = userIdTable().find(userID);
+    if (idx == INVALID_IDX) return 0;
+    ReadLock lock(coreMutex);
+    std::lock_guard<std::mutex> inboxLock(inboxLocks[idx % TIMELINE_LOCKS]);
+    size_t unread = inboxes.unreadCount(idx);
+    if (idx >= inboxReadMarks.size()) return unread;
+
+    // Author lists are oldest first: count the tail above the read mark
+    const FeedKey& mark = inboxReadMarks[idx];
+    for (const FeedSource& src : pulledInboxSources(idx)) {
+        const PostIdx* end = src.data + src.size;
+        unread += end - std::upper_bound(src.data, end, mark, [this](const FeedKey& key, PostIdx post) {
+            return olderThan(key, postTable.key(post));
+        });
+    }
+    return unread;
+}
+
+std::vector<PostRef> SystemCore::getInbox(const std::string& userID, size_t limit, bool unreadOnly) {
+    std::vector<PostRef> result;
+    UserIdx idx = userIdTable().find(userID);
+    if (idx == INVALID_IDX) return result;
+
+    ReadLock lock(coreMutex);
+    std::vector<PostIdx> handles;
+    FeedKey mark{0, 0};
+    {
+        std::lock_guard<std::mutex> inboxLock(inboxLocks[idx % TIMELINE_LOCKS]);
+        inboxes.recent(idx, limit, unreadOnly, handles);
+        if (idx < inboxReadMarks.size()) mark = inboxReadMarks[idx];
     }
+
+    // Merge in the newest pulled posts, both lists newest first
+    std::vector<PostIdx> pulled;
+    mergeFeed(pulledInboxSources(idx), FeedKey{UINT64_MAX, INVALID_IDX}, limit, pulled);
+    if (unreadOnly) {
+        auto read = std::find_if(pulled.begin(), pulled.end(),
+                                 [this, &mark](PostIdx post) { return !olderThan(mark, postTable.key(post)); });
+        pulled.erase(read, pulled.end());
+    }
+    if (!pulled.empty()) {
+        std::vector<PostIdx> merged;
+        merged.reserve(handles.size() + pulled.size());
+        std::merge(handles.begin(), handles.end(), pulled.begin(), pulled.end(), std::back_inserter(merged),
+                   [this](PostIdx a, PostIdx b) { return olderThan(postTable.key(b), postTable.key(a)); });
+        // Each post is either pushed or pulled; this only guards the merge
+        merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+        if (merged.size() > limit) merged.resize(limit);
+        handles.swap(merged);
+    }
+
+    result.reserve(handles.size());
+    for (PostIdx postIdx : handles) {
+        if (findPost(postIdx)) result.push_back(posts[postIdx]);
+    }
+    return result;
+}
+
+// Pulled posts are read up to the newest one now in the pulled lists
+void SystemCore::markInboxRead(const std::string& userID) {
+    UserIdx idx = userIdTable().find(userID);
+    if (idx == INVALID_IDX) return;
+    ReadLock lock(coreMutex);
+    std::vector<FeedSource> sources = pulledInboxSources(idx);
+    std::lock_guard<std::mutex> inboxLock(inboxLocks[idx % TIMELINE_LOCKS]);
+    inboxes.markAllRead(idx);
+    if (idx >= inboxReadMarks.size()) return;
+    FeedKey& mark = inboxReadMarks[idx];
+    for (const FeedSource& src : sources) {
+        FeedKey newest = postTable.key(src.data[src.size - 1]);
+        if (olderThan(mark, newest)) mark = newest;
+    }
+}
+
+InboxStats SystemCore::getInboxStats() const {
+    ReadLock lock(coreMutex);
+    return inboxes.stats();
 }
 
 // ---------------------- Feed Generation ----------------------
-std::vector<Post> SystemCore::generateFeedForUser(const std::string& userID) {
-    std::vector<Post> feed;
+// Cursors are "<timestamp>:<postID>" of the last post already shown. The
+// PostIdx tie-break is per process, so cursors are not meant to be stored.
+static std::string encodeCursor(const Post& p) {
+    return std::to_string(p.getTimestamp()) + ":" + p.getPostID();
+}
+
+static bool decodeCursor(const std::string& cursor, FeedKey& key) {
+    size_t colon = cursor.find(':');
+    if (colon == std::string::npos) return false;
+    if (!parseUint64(std::string_view(cursor).substr(0, colon), key.timestamp)) return false;
+
+    // An unknown post sorts after every post with the same timestamp
+    key.idx = postIdTable().find(std::string_view(cursor).substr(colon + 1));
+    return true;
+}
+
+std::vector<PostRef> SystemCore::generateFeedForUser(const std::string& userID) {
+    return getFeedPage(userID, SIZE_MAX).posts;
+}
+
+FeedPage SystemCore::getFeedPage(const std::string& userID, size_t limit, const std::string& before) {
+    FeedPage page;
+
+    ReadLock lock(coreMutex);
+    const User* user = findUser(userIdTable().find(userID));
+    if (!user || limit == 0) return page;
+
+    FeedKey bound{UINT64_MAX, INVALID_IDX};
+    if (!before.empty() && !decodeCursor(before, bound)) {
+        log("WARNING", "Ignoring malformed feed cursor: " + before);
+        bound = FeedKey{UINT64_MAX, INVALID_IDX};
+    }
+
+    std::vector<PostIdx> handles;
+    bool more = feedHandles(*user, bound, limit, handles);
+
+    page.posts.reserve(handles.size());
+    for (PostIdx idx : handles) {
+        page.posts.push_back(posts[idx]);
+    }
+    if (more) {
+        page.nextCursor = encodeCursor(*page.posts.back());
+    }
+    return page;
+}
 
-    User* user = getUser(userID);
-    if (!user) return feed;
+// Up to limit handles older than bound, from the home timeline where the
+// strategy keeps one; returns true if more remain
+bool SystemCore::feedHandles(const User& user, const FeedKey& bound, size_t limit,
+                             std::vector<PostIdx>& out) {
+    bool more = false;
+    if (feedStrategy == FeedStrategy::FanOutOnRead || !mergeTimelineFeed(user, bound, limit, out, more)) {
+        out.clear();
+        more = mergeFeed(followeeSources(user, FolloweeSet::All), bound, limit, out);
+    }
+    return more;
+}
+
+std::vector<PostRef> SystemCore::generateRankedFeedForUser(const std::string& userID, size_t k) {
+    return getRankedFeed<EngagementScorer>(userID, k);
+}
+
+// Stage one of a ranked feed: the newest posts from the user's followees,
+// taken the same way as a feed page, and their features. Caller holds
+// coreMutex shared.
+bool SystemCore::collectCandidates(const std::string& userID, size_t limit, FeedCandidates& out) {
+    out.clear();
+    const User* user = findUser(userIdTable().find(userID));
+    if (!user || limit == 0) return false;
+
+    feedHandles(*user, FeedKey{UINT64_MAX, INVALID_IDX}, limit, out.posts);
+
+    std::vector<AuthorAffinity::Entry> tally;
+    affinity.copyFor(user->getIdx(), tally);
+    auto byAuthor = [](const AuthorAffinity::Entry& e, UserIdx author) { return e.author < author; };
+
+    const uint64_t now = currentTimestamp();
+    const size_t n = out.posts.size();
+    out.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        PostIdx idx = out.posts[i];
+        uint64_t ts = postTable.timestamp(idx);
+        out.ageHours[i] = (ts < now) ? static_cast<float>(now - ts) / 3600.0f : 0.0f;
+        out.likes[i] = static_cast<float>(postTable.likes(idx));
+
+        UserIdx author = postTable.author(idx);
+        auto it = std::lower_bound(tally.begin(), tally.end(), author, byAuthor);
+        out.affinity[i] = (it != tally.end() && it->author == author) ? static_cast<float>(it->likes) : 0.0f;
+    }
+    return n > 0;
+}
+
+// Each source is already time ordered, so a page is a k-way merge: one heap
+// entry per source, popping the newest until the page is full. Fills out
+// with up to limit handles older than bound; returns true if more remain.
+bool SystemCore::mergeFeed(const std::vector<FeedSource>& sources, const FeedKey& bound,
+                           size_t limit, std::vector<PostIdx>& out) const {
+    // Next (older) post of one source: data[pos - 1]
+    struct Head {
+        FeedKey key;
+        const PostIdx* data;
+        size_t pos;
+    };
+    auto newerFirst = [](const Head& a, const Head& b) { return olderThan(a.key, b.key); };
+    auto older = [this](PostIdx idx, const FeedKey& key) { return olderThan(postTable.key(idx), key); };
+
+    std::vector<Head> heap;
+    heap.reserve(sources.size());
+    for (const FeedSource& src : sources) {
+        // Skip everything at or after the bound
+        size_t pos = std::lower_bound(src.data, src.data + src.size, bound, older) - src.data;
+        if (pos > 0) {
+            heap.push_back(Head{postTable.key(src.data[pos - 1]), src.data, pos});
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), newerFirst);
 
-    std::vector<std::string> following = user->getFollowing();
+    while (!heap.empty() && out.size() < limit) {
+        std::pop_heap(heap.begin(), heap.end(), newerFirst);
+        Head& head = heap.back();
+        out.push_back(head.data[head.pos - 1]);
 
-    // Collect posts from followed users
-    for (const std::string& followedID : following) {
-        std::vector<Post> userPosts = getPostsByUser(followedID);
-        feed.insert(feed.end(), userPosts.begin(), userPosts.end());
+        if (--head.pos > 0) {
+            head.key = postTable.key(head.data[head.pos - 1]);
+            std::push_heap(heap.begin(), heap.end(), newerFirst);
+        } else {
+            heap.pop_back();
+        }
+    }
+    return !heap.empty();
+}
+
+// Author lists of the user's followees. Celebrities are the authors whose
+// posts are merged at read time instead of being pushed into timelines.
+std::vector<SystemCore::FeedSource> SystemCore::followeeSources(const User& user, FolloweeSet which) const {
+    std::vector<UserIdx> following;
+    graph.following(user.getIdx(), following);
+
+    std::vector<FeedSource> sources;
+    for (UserIdx followedIdx : following) {
+        if (followedIdx >= postsByAuthor.size() || postsByAuthor[followedIdx].empty()) continue;
+        if (which != FolloweeSet::All &&
+            isCelebrity(followedIdx) != (which == FolloweeSet::Celebrities)) {
+            continue;
+        }
+        const std::vector<PostIdx>& list = postsByAuthor[followedIdx];
+        sources.push_back(FeedSource{list.data(), list.size()});
     }
+    return sources;
+}
 
-    // Sort by timestamp descending
-    std::sort(feed.begin(), feed.end(),
-              [](const Post& a, const Post& b) { return a.getTimestamp() > b.getTimestamp(); });
+// ---------------------- Home Timelines ----------------------
+bool SystemCore::isCelebrity(UserIdx idx) const {
+    return feedStrategy == FeedStrategy::Hybrid && graph.followerCount(idx) >= celebrityThreshold;
+}
 
-    return feed;
+void SystemCore::setFeedStrategy(FeedStrategy strategy, size_t threshold, size_t capacity) {
+    WriteLock lock(coreMutex);
+    feedStrategy = strategy;
+    celebrityThreshold = threshold;
+    timelineCapacity = capacity;
+    for (HomeTimeline& tl : homeTimelines) {
+        tl.markStale();
+    }
+}
+
+FeedStrategy SystemCore::getFeedStrategy() const {
+    ReadLock lock(coreMutex);
+    return feedStrategy;
+}
+
+// Timeline merged with the celebrity authors it leaves out. Returns false when
+// the page reaches past what a truncated timeline still covers; the caller
+// then falls back to a read-time merge.
+bool SystemCore::mergeTimelineFeed(const User& user, const FeedKey& bound, size_t limit,
+                                   std::vector<PostIdx>& out, bool& more) {
+    std::lock_guard<std::mutex> timelineLock(timelineLocks[user.getIdx() % TIMELINE_LOCKS]);
+    const HomeTimeline& tl = freshTimeline(user.getIdx());
+
+    std::vector<FeedSource> sources = followeeSources(user, FolloweeSet::Celebrities);
+    size_t length;
+    const PostIdx* run = tl.firstRun(length);
+    if (length > 0) sources.push_back(FeedSource{run, length});
+    run = tl.secondRun(length);
+    if (length > 0) sources.push_back(FeedSource{run, length});
+
+    more = mergeFeed(sources, bound, limit, out);
+    if (!tl.isTruncated()) return true;
+
+    // Non-celebrity posts older than the ring's oldest entry may be missing
+    if (tl.empty() || out.size() < limit) return false;
+    if (olderThan(postTable.key(out.back()), postTable.key(tl.oldest()))) return false;
+    more = true;    // older posts exist past the end of the ring
+    return true;
+}
+
+// Push a new post into the live timelines of the author's followers.
+// Stale timelines are skipped; they pick the post up when rebuilt.
+void SystemCore::fanOutPost(const Post& p) {
+    if (feedStrategy == FeedStrategy::FanOutOnRead) return;
+
+    if (isCelebrity(p.getAuthorIdx())) return;
+
+    std::vector<UserIdx> followers;
+    graph.followers(p.getAuthorIdx(), followers);
+
+    FeedKey key = postTable.key(p.getIdx());
+    for (UserIdx followerIdx : followers) {
+        if (followerIdx >= homeTimelines.size()) continue;
+        HomeTimeline& tl = homeTimelines[followerIdx];
+        if (tl.isStale()) continue;
+
+        // The ring only appends; a post older than its newest entry forces a rebuild
+        if (!tl.empty() && olderThan(key, postTable.key(tl.newest()))) {
+            tl.markStale();
+            continue;
+        }
+        tl.push(p.getIdx());
+    }
+}
+
+void SystemCore::invalidateTimeline(UserIdx idx) {
+    if (idx < homeTimelines.size()) homeTimelines[idx].markStale();
+}
+
+void SystemCore::invalidateFollowerTimelines(UserIdx idx) {
+    std::vector<UserIdx> followers;
+    graph.followers(idx, followers);
+    for (UserIdx followerIdx : followers) {
+        invalidateTimeline(followerIdx);
+    }
+}
+
+// Caller holds coreMutex and the timeline's lock shard
+HomeTimeline& SystemCore::freshTimeline(UserIdx idx) {
+    HomeTimeline& tl = homeTimelines[idx];
+    if (tl.isStale()) {
+        std::vector<PostIdx> newest;
+        bool more = mergeFeed(followeeSources(*users[idx], FolloweeSet::Regular),
+                              FeedKey{UINT64_MAX, INVALID_IDX}, timelineCapacity, newest);
+        tl.reset(timelineCapacity);
+        for (auto it = newest.rbegin(); it != newest.rend(); ++it) {
+            tl.push(*it);
+        }
+        if (more) tl.markTruncated();
+    }
+    return tl;
+}
+
+// ---------------------- Trending ----------------------
+std::vector<TrendingTag> SystemCore::getTrending(TrendWindow window, size_t k) const {
+    ReadLock lock(coreMutex);
+    std::vector<TrendingTag> result;
+    trending.top(window, k, result);
+    return result;
+}
+
+TrendingStats SystemCore::getTrendingStats() const {
+    ReadLock lock(coreMutex);
+    return trending.stats();
+}
+
+// ---------------------- Search ----------------------
+std::vector<PostRef> SystemCore::searchPosts(const std::string& query, SearchMode mode,
+                                             PostOrder order, size_t limit) {
+    std::vector<std::string> terms;
+    SearchIndex::tokenize(query, terms);
+    std::vector<PostRef> result;
+    if (terms.empty() || limit == 0) return result;
+
+    ReadLock lock(coreMutex);
+    std::vector<PostIdx> handles;
+    search.findPosts(terms, mode, handles);
+    postTable.sort(handles, order, limit);
+    result.reserve(handles.size());
+    for (PostIdx idx : handles) {
+        result.push_back(posts[idx]);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<const User>> SystemCore::searchUsers(const std::string& query, SearchMode mode,
+                                                                 size_t limit) {
+    std::vector<std::string> terms;
+    SearchIndex::tokenize(query, terms);
+    std::vector<std::shared_ptr<const User>> result;
+    if (terms.empty()) return result;
+
+    ReadLock lock(coreMutex);
+    std::vector<UserIdx> handles;
+    search.findUsers(terms, mode, handles);
+    for (size_t i = 0; i < handles.size() && result.size() < limit; ++i) {
+        if (findUser(handles[i])) result.push_back(users[handles[i]]);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<const User>> SystemCore::findUsersByPrefix(const std::string& prefix, size_t limit) {
+    std::vector<std::shared_ptr<const User>> result;
+    if (prefix.empty()) return result;
+
+    ReadLock lock(coreMutex);
+    std::vector<UserIdx> handles;
+    search.usernamesWithPrefix(prefix, limit, handles);
+    for (UserIdx idx : handles) {
+        if (findUser(idx)) result.push_back(users[idx]);
+    }
+    return result;
+}
+
+SearchStats SystemCore::getSearchStats() const {
+    ReadLock lock(coreMutex);
+    return search.stats();
+}
+
+// ---------------------- Follow Suggestions ----------------------
+void SystemCore::countFollowEdit(UserIdx idx) {
+    if (idx >= followEdits.size()) followEdits.resize(idx + 1, 0);
+    followEdits[idx]++;
+}
+
+uint32_t SystemCore::followEditsOf(UserIdx idx) const {
+    return (idx < followEdits.size()) ? followEdits[idx] : 0;
+}
+
+// Drops accounts followed or removed since list was computed
+std::vector<FollowRecommendation> SystemCore::resolveSuggestions(UserIdx user,
+                                                                 const std::vector<FollowSuggestion>& list,
+                                                                 size_t k) const {
+    std::vector<FollowRecommendation> result;
+    for (size_t i = 0; i < list.size() && result.size() < k; ++i) {
+        UserIdx candidate = list[i].user;
+        if (findUser(candidate) && !graph.isFollowing(user, candidate)) {
+            result.push_back(FollowRecommendation{users[candidate], list[i].mutuals});
+        }
+    }
+    return result;
+}
+
+std::vector<FollowRecommendation> SystemCore::recommendFollows(const std::string& userID, size_t k,
+                                                               bool weighByEngagement) {
+    ReadLock lock(coreMutex);
+    UserIdx user = userIdTable().find(userID);
+    if (!findUser(user) || k == 0) return {};
+
+    if (weighByEngagement && k <= suggestionDepth && user < suggestionCache.size() &&
+        suggestionEdits[user] == followEditsOf(user)) {
+        std::vector<FollowRecommendation> cached = resolveSuggestions(user, suggestionCache[user], k);
+        // A short list is complete unless accounts on it were removed since
+        if (cached.size() == k || suggestionCache[user].size() < suggestionDepth) return cached;
+    }
+
+    static thread_local FollowRecommender recommender;
+    std::vector<FollowSuggestion> list;
+    recommender.recommend(graph, weighByEngagement ? &affinity : nullptr, user, k, list);
+    return resolveSuggestions(user, list, k);
+}
+
+// One pool task per block of users, with at most half the workers' worth
+// queued at once so other pool jobs are not stuck behind the whole run.
+// Each in-flight slot reuses its own recommender's scratch arrays. The
+// shared lock is taken per block, so writers get in during a long run.
+void SystemCore::precomputeRecommendations(size_t k) {
+    static constexpr size_t BLOCK = 256;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::vector<FollowSuggestion>> lists;
+    std::vector<uint32_t> edits;
+    {
+        ReadLock lock(coreMutex);
+        lists.resize(users.size());
+        edits.resize(users.size());
+    }
+
+    const size_t slots = std::max<size_t>(1, workerPool.size() / 2);
+    std::vector<FollowRecommender> recommenders(slots);
+    std::vector<std::future<void>> inFlight(slots);
+    size_t block = 0;
+    for (size_t begin = 0; begin < lists.size(); begin += BLOCK, ++block) {
+        size_t slot = block % slots;
+        if (inFlight[slot].valid()) inFlight[slot].get();
+        FollowRecommender& recommender = recommenders[slot];
+        inFlight[slot] = workerPool.submit([this, &lists, &edits, &recommender, begin, k] {
+            ReadLock lock(coreMutex);
+            size_t end = std::min(lists.size(), begin + BLOCK);
+            for (size_t u = begin; u < end; ++u) {
+                if (findUser(static_cast<UserIdx>(u))) {
+                    edits[u] = followEditsOf(static_cast<UserIdx>(u));
+                    recommender.recommend(graph, &affinity, static_cast<UserIdx>(u), k, lists[u]);
+                }
+            }
+        });
+    }
+    for (std::future<void>& f : inFlight) {
+        if (f.valid()) f.get();
+    }
+
+    WriteLock lock(coreMutex);
+    suggestionCache.swap(lists);
+    suggestionEdits.swap(edits);
+    suggestionDepth = k;
+    log("INFO", "Follow suggestions for " + std::to_string(suggestionCache.size()) + " users in " +
+        std::to_string(elapsedMs(start)) + " ms");
+}
+
+// ---------------------- Graph Analytics ----------------------
+GraphSummary SystemCore::getGraphSummary() {
+    SocialGraph view;
+    size_t vertexCount;
+    {
+        ReadLock lock(coreMutex);
+        view = graph;
+        vertexCount = users.size();
+    }
+    return summarizeGraph(view, vertexCount, workerPool);
+}
+
+std::vector<std::shared_ptr<const User>> SystemCore::getMutualFollowers(const std::string& userA,
+                                                                        const std::string& userB) {
+    ReadLock lock(coreMutex);
+    std::vector<std::shared_ptr<const User>> result;
+    UserIdx a = userIdTable().find(userA);
+    UserIdx b = userIdTable().find(userB);
+    if (!findUser(a) || !findUser(b)) return result;
+
+    std::vector<UserIdx> both;
+    mutualFollowers(graph, a, b, both);
+    for (UserIdx idx : both) {
+        if (findUser(idx)) result.push_back(users[idx]);
+    }
+    return result;
+}
+
+int SystemCore::getDegreesOfSeparation(const std::string& fromID, const std::string& toID, int maxDepth) {
+    SocialGraph view;
+    size_t vertexCount;
+    UserIdx from, to;
+    {
+        ReadLock lock(coreMutex);
+        from = userIdTable().find(fromID);
+        to = userIdTable().find(toID);
+        if (!findUser(from) || !findUser(to)) return -1;
+        view = graph;
+        vertexCount = users.size();
+    }
+    return degreesOfSeparation(view, vertexCount, from, to, maxDepth, workerPool);
+}
+
+std::vector<size_t> SystemCore::getReachByDistance(const std::string& userID, int maxDepth) {
+    SocialGraph view;
+    size_t vertexCount;
+    UserIdx from;
+    {
+        ReadLock lock(coreMutex);
+        from = userIdTable().find(userID);
+        if (!findUser(from)) return {};
+        view = graph;
+        vertexCount = users.size();
+    }
+    std::vector<size_t> counts;
+    reachByDistance(view, vertexCount, from, maxDepth, workerPool, counts);
+    return counts;
 }
 
 // ---------------------- Stats & Cleanup ----------------------
 int SystemCore::getUserCount() const {
-    return users.size();
+    ReadLock lock(coreMutex);
+    return static_cast<int>(userCount);
 }
 
 int SystemCore::getPostCount() const {
-    return posts.size();
+    ReadLock lock(coreMutex);
+    return static_cast<int>(postCount);
 }
 
 // Cleanup
 void SystemCore::clearAllData() {
-    std::lock_guard<std::mutex> lock(coreMutex);
+    WriteLock lock(coreMutex);
     users.clear();
     posts.clear();
+    postTable.clear();
     userNotifiers.clear();
+    usernameIndex.clear();
+    postsByAuthor.clear();
+    homeTimelines.clear();
+    graph.clear();
+    likeIndex.clear();
+    affinity.clear();
+    inboxes.clear();
+    inboxReadMarks.clear();
+    pulledInboxPosts.clear();
+    trending.clear();
+    search.clear();
+    suggestionCache.clear();
+    suggestionEdits.clear();
+    followEdits.clear();
+    suggestionDepth = 0;
+    userCount = 0;
+    postCount = 0;
     log("INFO", "All data cleared");
 }
@@ -0,0 +1,157 @@
+#include "trending.h"
+#include <algorithm>
+#include <cctype>
+
+TrendingHashtags::TrendingHashtags()
+    : ring(BUCKETS), head(0), started(false) {
+    windows[static_cast<size_t>(TrendWindow::LastHour)].buckets = 3600 / BUCKET_SECONDS;
+    windows[static_cast<size_t>(TrendWindow::LastDay)].buckets = BUCKETS;
+}
+
+// ---------------------- Tokenizing ----------------------
+static bool isTagChar(unsigned char c) {
+    return std::isalnum(c) || c == '_';
+}
+
+// A post counts once per distinct tag
+void TrendingHashtags::extractHashtags(std::string_view text, std::vector<std::string>& out) {
+    out.clear();
+    size_t i = 0;
+    while ((i = text.find('#', i)) != std::string_view::npos) {
+        size_t start = ++i;
+        while (i < text.size() && isTagChar(static_cast<unsigned char>(text[i]))) ++i;
+        if (i == start) continue;
+
+        std::string tag(text.substr(start, std::min(i - start, MAX_TAG_LENGTH)));
+        for (char& c : tag) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (std::find(out.begin(), out.end(), tag) == out.end()) out.push_back(std::move(tag));
+    }
+}
+
+// ---------------------- Counting ----------------------
+void TrendingHashtags::add(std::string_view text, uint64_t timestamp) {
+    counters.posts++;
+    extractHashtags(text, scratch);
+    if (scratch.empty()) return;
+
+    advanceTo(timestamp);
+    uint64_t bucket = timestamp / BUCKET_SECONDS;
+    if (bucket + BUCKETS <= head) {
+        counters.stale += scratch.size();
+        return;
+    }
+
+    CountMinSketch& slot = ring[bucket % BUCKETS];
+    for (const std::string& tag : scratch) {
+        uint64_t hash = CountMinSketch::hash(tag);
+        slot.add(hash);
+        for (Window& w : windows) {
+            if (bucket + w.buckets <= head) continue;
+            w.sketch.add(hash);
+            offer(w, hash, tag);
+        }
+    }
+    counters.hashtags += scratch.size();
+}
+
+// Track the tag if its estimate beats the weakest candidate
+void TrendingHashtags::offer(Window& w, uint64_t hash, const std::string& tag) {
+    uint32_t estimate = w.sketch.estimate(hash);
+    for (Candidate& c : w.candidates) {
+        if (c.hash == hash && c.tag == tag) {
+            c.count = estimate;
+            return;
+        }
+    }
+    if (w.candidates.size() < CANDIDATES) {
+        w.candidates.push_back(Candidate{hash, tag, estimate});
+        return;
+    }
+    auto weakest = std::min_element(w.candidates.begin(), w.candidates.end(),
+                                    [](const Candidate& a, const Candidate& b) { return a.count < b.count; });
+    if (estimate > weakest->count) *weakest = Candidate{hash, tag, estimate};
+}
+
+// ---------------------- Sliding ----------------------
+void TrendingHashtags::advanceTo(uint64_t timestamp) {
+    uint64_t bucket = timestamp / BUCKET_SECONDS;
+    if (!started) {
+        head = bucket;
+        started = true;
+        return;
+    }
+    if (bucket <= head) return;
+
+    // A jump past the whole ring empties everything
+    if (bucket - head >= BUCKETS) {
+        for (CountMinSketch& s : ring) s.clear();
+        for (Window& w : windows) {
+            w.sketch.clear();
+            w.candidates.clear();
+        }
+        head = bucket;
+        return;
+    }
+
+    for (uint64_t b = head + 1; b <= bucket; ++b) {
+        for (Window& w : windows) {
+            if (b >= w.buckets) expire(w, b - w.buckets);
+        }
+        ring[b % BUCKETS].clear();
+    }
+    head = bucket;
+    for (Window& w : windows) refreshCandidates(w);
+}
+
+// The window no longer covers bucket; it is still in the ring until its
+// slot is reused, which happens after every window has let go of it
+void TrendingHashtags::expire(Window& w, uint64_t bucket) {
+    w.sketch.subtract(ring[bucket % BUCKETS]);
+}
+
+void TrendingHashtags::refreshCandidates(Window& w) {
+    for (Candidate& c : w.candidates) c.count = w.sketch.estimate(c.hash);
+    w.candidates.erase(std::remove_if(w.candidates.begin(), w.candidates.end(),
+                                      [](const Candidate& c) { return c.count == 0; }),
+                       w.candidates.end());
+}
+
+// ---------------------- Queries ----------------------
+void TrendingHashtags::top(TrendWindow window, size_t k, std::vector<TrendingTag>& out) const {
+    const Window& w = windows[static_cast<size_t>(window)];
+    std::vector<const Candidate*> order;
+    order.reserve(w.candidates.size());
+    for (const Candidate& c : w.candidates) order.push_back(&c);
+
+    k = std::min(k, order.size());
+    std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                      [](const Candidate* a, const Candidate* b) {
+                          return a->count != b->count ? a->count > b->count : a->tag < b->tag;
+                      });
+    out.clear();
+    out.reserve(k);
+    for (size_t i = 0; i < k; ++i) {
+        out.push_back(TrendingTag{order[i]->tag, order[i]->count});
+    }
+}
+
+void TrendingHashtags::clear() {
+    for (CountMinSketch& s : ring) s.clear();
+    for (Window& w : windows) {
+        w.sketch.clear();
+        w.candidates.clear();
+    }
+    head = 0;
+    started = false;
+    counters = TrendingStats();
+}
+
+TrendingStats TrendingHashtags::stats() const {
+    TrendingStats s = counters;
+    for (const CountMinSketch& sketch : ring) s.bytes += sketch.memoryBytes();
+    for (const Window& w : windows) {
+        s.bytes += w.sketch.memoryBytes() + w.candidates.capacity() * sizeof(Candidate);
+        for (const Candidate& c : w.candidates) s.bytes += c.tag.capacity();
+    }
+    return s;
+}
@@ -1,7 +1,13 @@
 #include "../include/Utils.h"
-#include <iostream>
-#include <fstream>
+#include "../include/field_parser.h"
+#include "../include/async_logger.h"
 #include <random>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 // Generate unique ID with prefix
 std::string generateID(const std::string& prefix) {
@@ -21,10 +27,16 @@ uint64_t currentTimestamp() {
 // Format timestamp for display
 std::string formatTimestamp(uint64_t timestamp) {
     std::time_t time = static_cast<std::time_t>(timestamp);
-    std::tm* tm_info = std::localtime(&time);
+    std::tm tm_info{};
+    // Reentrant variants: log() formats timestamps from several threads
+#ifdef _WIN32
+    localtime_s(&tm_info, &time);
+#else
+    localtime_r(&time, &tm_info);
+#endif
     
     char buffer[80];
-    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm_info);
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm_info);
     return std::string(buffer);
 }
 
@@ -42,7 +54,7 @@ std::vector<std::string> safeSplit(const std::string& s, char delim) {
 }
 
 // URL encode for safe serialization
-std::string urlEncode(const std::string& value) {
+std::string urlEncode(std::string_view value) {
     std::ostringstream escaped;
     escaped.fill('0');
     escaped << std::hex;
@@ -61,16 +73,7 @@ std::string urlEncode(const std::string& value) {
 // URL decode
 std::string urlDecode(const std::string& value) {
     std::string result;
-    for (size_t i = 0; i < value.length(); ++i) {
-        if (value[i] == '%' && i + 2 < value.length()) {
-            std::string hex = value.substr(i + 1, 2);
-            char ch = static_cast<char>(std::stoi(hex, nullptr, 16));
-            result += ch;
-            i += 2;
-        } else {
-            result += value[i];
-        }
-    }
+    percentDecode(value, result);
     return result;
 }
 
@@ -82,15 +85,41 @@ std::string trim(const std::string& str) {
     return str.substr(first, (last - first + 1));
 }
 
-// Simple logging function
+// Logging: queued for the background writer (see AsyncLogger)
 void log(const std::string& level, const std::string& message) {
-    std::ofstream logFile("data/logs.txt", std::ios::app);
-    if (logFile.is_open()) {
-        logFile << "[" << formatTimestamp(currentTimestamp()) << "] "
-                << level << ": " << message << "\n";
-        logFile.close();
-    }
-    
-    // Also print to console for debugging
-    std::cout << "[" << level << "] " << message << "\n";
-}
\ No newline at end of file
+    AsyncLogger::getInstance().write(AsyncLogger::parseLevel(level), message);
+}
+
+void flushLog() {
+    AsyncLogger::getInstance().flush();
+}
+
+// ---------------------- Durability ----------------------
+bool fsyncFile(const std::string& path) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return ok;
+}
+
+// Windows has no directory handle to flush; NTFS journals the rename
+bool fsyncDirectory(const std::string& dir) {
+#ifdef _WIN32
+    (void)dir;
+    return true;
+#else
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
@@ -0,0 +1,86 @@
+#include "sys_core.h"
+#include "async_logger.h"
+#include "utils.h"
+#include <filesystem>
+#include <cstdio>
+
+// Inbox delivery when an author crosses celebrityThreshold. Posts made
+// below the threshold are pushed to followers' rings, posts made at or
+// above it are pulled at read time; each post must show up exactly once,
+// whichever way the author's follower count has moved since.
+//
+// usage: inbox_test
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what.c_str());
+        failures++;
+    }
+}
+
+static std::string inboxOf(SystemCore& core, const std::string& user) {
+    std::string ids;
+    for (const PostRef& p : core.getInbox(user, 50)) {
+        if (!ids.empty()) ids += ' ';
+        ids += p->getPostID();
+    }
+    return ids;
+}
+
+static void expectInbox(SystemCore& core, const std::string& user, const std::string& ids, size_t unread,
+                        const std::string& step) {
+    std::string got = inboxOf(core, user);
+    check(got == ids, step + ": inbox of " + user + " is \"" + got + "\", expected \"" + ids + "\"");
+    size_t count = core.getUnreadCount(user);
+    check(count == unread, step + ": " + user + " has " + std::to_string(count) + " unread, expected " +
+                               std::to_string(unread));
+}
+
+int main() {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "sfe_inbox_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "data");
+    fs::current_path(dir);
+    AsyncLogger::getInstance().setMinLevel(LogLevel::Warning);
+
+    SystemCore& core = SystemCore::getInstance();
+    core.loadAllData();
+    core.setFsyncPolicy(FsyncPolicy::Never);
+    core.setFeedStrategy(FeedStrategy::Hybrid, 2);
+    for (const char* id : {"u_author", "u_fan1", "u_fan2"}) {
+        core.addUser(User(id, std::string(id).substr(2)));
+    }
+    uint64_t ts = currentTimestamp() + 10;
+    auto post = [&](const std::string& id) { core.addPost(Post(id, "u_author", "post " + id, ts++)); };
+
+    // One follower: pushed
+    core.followUser("u_fan1", "u_author");
+    post("p_1");
+    expectInbox(core, "u_fan1", "p_1", 1, "below threshold");
+
+    // Crossing up: p_1 stays in the ring and is not pulled a second time
+    core.followUser("u_fan2", "u_author");
+    expectInbox(core, "u_fan1", "p_1", 1, "crossed up");
+    post("p_2");
+    expectInbox(core, "u_fan1", "p_2 p_1", 2, "celebrity post");
+    expectInbox(core, "u_fan2", "p_2", 1, "celebrity post");
+
+    // Dropping back: p_2 is still pulled, new posts are pushed again
+    core.unfollowUser("u_fan2", "u_author");
+    expectInbox(core, "u_fan1", "p_2 p_1", 2, "dropped back");
+    post("p_3");
+    expectInbox(core, "u_fan1", "p_3 p_2 p_1", 3, "regular post again");
+
+    // Read marks cover both kinds
+    core.markInboxRead("u_fan1");
+    expectInbox(core, "u_fan1", "p_3 p_2 p_1", 0, "marked read");
+    core.followUser("u_fan2", "u_author");
+    post("p_4");
+    expectInbox(core, "u_fan1", "p_4 p_3 p_2 p_1", 1, "crossed up again");
+
+    if (failures == 0) std::printf("inbox: ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+#include "sys_core.h"
+#include "async_logger.h"
+#include <atomic>
+#include <thread>
+#include <random>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+
+// Concurrency stress test: reader threads call every query API while
+// writer threads like, follow, unfollow, post and edit, and background
+// compaction runs every second. Built with -fsanitize=thread by
+// `make stress`, so data races are reported as well.
+//
+// A public method that takes coreMutex shared and then calls another one
+// that does the same deadlocks as soon as a writer queues in between
+// (lock_shared waits at the writer gate while the outer read lock holds
+// the writer off). A watchdog fails the run if no thread makes progress
+// for WATCHDOG_SECONDS.
+//
+// usage: stress_test [seconds] [readers] [writers]
+
+static constexpr size_t USERS = 300;
+static constexpr size_t POSTS = 3000;
+static constexpr int WATCHDOG_SECONDS = 30;
+
+static std::atomic<bool> stopping{false};
+static std::atomic<uint64_t> operations{0};
+
+static std::string userID(size_t i) { return "u_" + std::to_string(1000 + i); }
+static std::string postID(size_t i) { return "p_" + std::to_string(1000 + i); }
+
+// ---------------------- Setup ----------------------
+// SystemCore keeps its files in data/ under the working directory
+static void enterScratchDir() {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "sfe_stress_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "data");
+    fs::current_path(dir);
+}
+
+static void seed(SystemCore& core) {
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < USERS; ++i) {
+        core.addUser(User(userID(i), "user" + std::to_string(i), "User " + std::to_string(i), "bio #stress"));
+    }
+    for (size_t i = 0; i < USERS * 10; ++i) {
+        core.followUser(userID(rng() % USERS), userID(rng() % USERS));
+    }
+    for (size_t i = 0; i < POSTS; ++i) {
+        core.addPost(Post(postID(i), userID(rng() % USERS), "seed post #tag" + std::to_string(i % 7), 1700000000 + i));
+    }
+    core.updateNextPostID();
+}
+
+// ---------------------- Workers ----------------------
+static void readerLoop(SystemCore& core, unsigned seedValue) {
+    std::mt19937 rng(seedValue);
+    uint64_t n = 0;
+    while (!stopping) {
+        const std::string user = userID(rng() % USERS);
+        const std::string other = userID(rng() % USERS);
+        switch (n % 16) {
+            case 0: core.getFeedPage(user, 20); break;
+            case 1: core.generateRankedFeedForUser(user, 10); break;
+            case 2: core.isFollowing(user, other); break;
+            case 3: core.hasLiked(user, postID(rng() % POSTS)); break;
+            case 4: core.getInbox(user, 10); break;
+            case 5: core.searchPosts("seed post", SearchMode::All, PostOrder::MostLiked, 10); break;
+            case 6: core.recommendFollows(user, 5); break;
+            case 7: core.getTrending(TrendWindow::LastDay, 5); break;
+            case 8: core.getTopPosts(10, PostOrder::MostLiked); break;
+            case 9: core.getPostsByUser(user); break;
+            case 10: core.getMutualFollowers(user, other); break;
+            case 11: core.getDegreesOfSeparation(user, other, 3); break;
+            case 12: core.getFollowerIDs(user); break;
+            case 13: core.getFollowerCount(user); break;
+            case 14: core.getFollowingCount(user); break;
+            default: core.getTextMemoryStats(); break;
+        }
+        ++n;
+        operations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void writerLoop(SystemCore& core, unsigned seedValue) {
+    std::mt19937 rng(seedValue);
+    uint64_t n = 0;
+    while (!stopping) {
+        const std::string user = userID(rng() % USERS);
+        const std::string other = userID(rng() % USERS);
+        switch (n % 6) {
+            case 0: core.likePost(user, postID(rng() % POSTS)); break;
+            case 1: core.followUser(user, other); break;
+            case 2: core.unfollowUser(user, other); break;
+            case 3: core.addPost(Post(core.generatePostID(), user, "stress post #hot", 1800000000 + n)); break;
+            case 4: core.editPost(postID(rng() % POSTS), "edited post #tag" + std::to_string(n % 5)); break;
+            default: core.markInboxRead(user); break;
+        }
+        ++n;
+        operations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ---------------------- Checks ----------------------
+// Follow counts agree with the edge lists, in both directions
+static int checkGraph(SystemCore& core) {
+    int failures = 0;
+    size_t following = 0, followers = 0;
+    for (size_t i = 0; i < USERS; ++i) {
+        std::vector<std::string> out = core.getFollowingIDs(userID(i));
+        std::vector<std::string> in = core.getFollowerIDs(userID(i));
+        if (out.size() != static_cast<size_t>(core.getFollowingCount(userID(i))) ||
+            in.size() != static_cast<size_t>(core.getFollowerCount(userID(i)))) {
+            std::printf("FAIL: follow counts of %s disagree with their lists\n", userID(i).c_str());
+            failures++;
+        }
+        for (const std::string& followee : out) {
+            if (!core.isFollowing(userID(i), followee)) {
+                std::printf("FAIL: %s lists %s but isFollowing is false\n", userID(i).c_str(), followee.c_str());
+                failures++;
+            }
+        }
+        following += out.size();
+        followers += in.size();
+    }
+    if (following != followers) {
+        std::printf("FAIL: %zu following edges but %zu follower edges\n", following, followers);
+        failures++;
+    }
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    const int seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const int readers = argc > 2 ? std::atoi(argv[2]) : 4;
+    const int writers = argc > 3 ? std::atoi(argv[3]) : 2;
+
+    enterScratchDir();
+    AsyncLogger::getInstance().setMinLevel(LogLevel::Warning);
+    SystemCore& core = SystemCore::getInstance();
+    core.loadAllData();
+    core.setFsyncPolicy(FsyncPolicy::Never);
+    seed(core);
+    core.startBackgroundCompaction(std::chrono::seconds(1), 0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; ++i) threads.emplace_back(readerLoop, std::ref(core), 100 + i);
+    for (int i = 0; i < writers; ++i) threads.emplace_back(writerLoop, std::ref(core), 200 + i);
+
+    // A deadlocked run cannot be joined, so the watchdog exits the process
+    uint64_t lastCount = 0;
+    int idle = 0;
+    for (int elapsed = 0; elapsed < seconds || idle > 0; ++elapsed) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        uint64_t count = operations.load();
+        idle = (count == lastCount) ? idle + 1 : 0;
+        lastCount = count;
+        if (idle >= WATCHDOG_SECONDS) {
+            std::printf("FAIL: no progress for %d seconds (deadlock?)\n", WATCHDOG_SECONDS);
+            std::fflush(stdout);
+            std::_Exit(1);
+        }
+    }
+    stopping = true;
+    for (std::thread& t : threads) t.join();
+    core.stopBackgroundCompaction();
+    core.flushLikes();
+
+    int failures = checkGraph(core);
+    std::printf("stress: %llu operations by %d readers and %d writers in %d s, %s\n",
+                static_cast<unsigned long long>(operations.load()), readers, writers, seconds,
+                failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}